@@ -0,0 +1,95 @@
+// Pass a large result up through several layers of calls and count the deep
+// copies per call, returning by copy or via nonstd::move (move emulation in C++98).
+
+#include "nonstd/status_value_cpp98.hpp"
+
+#include <ctime>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace nonstd;
+
+struct samples
+{
+    static long copies;
+
+    std::vector<int> data;
+
+    samples() {}
+    samples( std::size_t n ) : data( n, 42 ) {}
+    samples( samples const & other ) : data( other.data ) { ++copies; }
+#if nsstsv_CPP11_OR_GREATER
+    samples( samples && other ) : data( std::move( other.data ) ) {}
+#endif
+    void swap( samples & other ) { data.swap( other.data ); }
+};
+
+long samples::copies = 0;
+
+typedef status_value< std::string, samples > result;
+
+result read_samples( std::size_t n )
+{
+    return result( "ok", samples( n ) );
+}
+
+// Two return statements prevent the named return value optimization:
+
+result layer_copy( int depth, std::size_t n )
+{
+    result sv = depth == 0 ? read_samples( n ) : layer_copy( depth - 1, n );
+
+    if ( ! sv ) return result( "failed" );
+    return sv;
+}
+
+result layer_move( int depth, std::size_t n )
+{
+    result sv = depth == 0 ? read_samples( n ) : layer_move( depth - 1, n );
+
+    if ( ! sv ) return result( "failed" );
+#if nsstsv_CPP11_OR_GREATER
+    return sv;  // moved implicitly
+#else
+    return nonstd::move( sv );
+#endif
+}
+
+template< typename F >
+void measure( char const * name, F layer, int depth, std::size_t n, int repeat )
+{
+    samples::copies = 0;
+    std::clock_t const start = std::clock();
+
+    std::size_t total = 0;
+    for ( int i = 0; i < repeat; ++i )
+    {
+        total += layer( depth, n ).value().data.size();
+    }
+
+    double const us = 1e6 * double( std::clock() - start ) / CLOCKS_PER_SEC / repeat;
+
+    std::cout << name << ": " << double( samples::copies ) / repeat << " copies per call, "
+        << us << " us per call (" << total / std::size_t( repeat ) << " samples)\n";
+}
+
+int main()
+{
+    int const depth = 4;
+    std::size_t const n = 100000;
+    int const repeat = 200;
+
+    std::cout << "layers: " << depth + 1 << ", samples: " << n << "\n";
+
+    measure( "return by copy        ", layer_copy, depth, n, repeat );
+    measure( "return nonstd::move() ", layer_move, depth, n, repeat );
+
+    return 0; // VC6
+}
+
+// cl -EHsc -O2 -I../include 08-move_emulation_cpp98.cpp && 08-move_emulation_cpp98.exe
+// g++ -std=c++98 -O2 -Wall -I../include -o 08-move_emulation_cpp98.exe 08-move_emulation_cpp98.cpp && 08-move_emulation_cpp98.exe
+// layers: 5, samples: 100000
+// return by copy        : 6 copies per call, 474.125 us per call (100000 samples)
+// return nonstd::move() : 1 copies per call, 404.635 us per call (100000 samples)
@@ -0,0 +1,95 @@
+// Keep a batch of results as std::vector<status_value> (array of structures)
+// or as status_value_vector (structure of arrays) and compare the cost of
+// summing the values and of counting the failures.
+
+#include "nonstd/status_value_batch.hpp"
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+using namespace nonstd;
+
+typedef status_value<int, double> result;
+
+template< typename F >
+double ns_per_element( F f, std::size_t n, int repeat )
+{
+    auto const start = std::chrono::steady_clock::now();
+
+    for ( int i = 0; i < repeat; ++i )
+        f();
+
+    std::chrono::duration<double, std::nano> const elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count() / double( n ) / repeat;
+}
+
+int main( int argc, char * argv[] )
+{
+    std::size_t n    = argc > 1 ? std::size_t( std::atol( argv[1] ) ) : 10000000u;
+    int success_rate = argc > 2 ? std::atoi( argv[2] ) : 90;
+    int const repeat = 10;
+
+    std::vector<result> aos;
+    status_value_vector<int, double> soa;
+
+    aos.reserve( n );
+    soa.reserve( n );
+
+    std::srand( 42 );
+
+    for ( std::size_t i = 0; i < n; ++i )
+    {
+        if ( std::rand() % 100 < success_rate )
+        {
+            aos.push_back( result( 0, double( i ) ) );
+            soa.emplace_back( 0, double( i ) );
+        }
+        else
+        {
+            aos.push_back( result( 1 ) );
+            soa.emplace_back( 1 );
+        }
+    }
+
+    double sum_aos = 0, sum_soa = 0;
+    std::size_t failed_aos = 0, failed_soa = 0;
+
+    double const t_sum_aos = ns_per_element( [&]
+    {
+        for ( result const & r : aos )
+            sum_aos += r.has_value() ? *r : 0.0;
+    }, n, repeat );
+
+    double const t_sum_soa = ns_per_element( [&]
+    {
+        double const * values = soa.values();
+
+        for ( std::size_t i = 0; i < soa.size(); ++i )
+            sum_soa += soa.has_value( i ) ? values[i] : 0.0;
+    }, n, repeat );
+
+    double const t_count_aos = ns_per_element( [&]
+    {
+        for ( result const & r : aos )
+            failed_aos += ! r.has_value();
+    }, n, repeat );
+
+    double const t_count_soa = ns_per_element( [&]
+    {
+        failed_soa += soa.count_failed();
+    }, n, repeat );
+
+    std::cout <<
+        "elements: " << n << ", success rate: " << success_rate << "%, bytes per element: AoS " << sizeof( result ) <<
+        ", SoA " << sizeof( double ) + sizeof( int ) << " + 1/8\n" <<
+        "sum values     : AoS " << t_sum_aos   << " ns, SoA " << t_sum_soa   << " ns per element" << ( sum_aos == sum_soa ? "" : " (mismatch)" ) << "\n" <<
+        "count failures : AoS " << t_count_aos << " ns, SoA " << t_count_soa << " ns per element" << ( failed_aos == failed_soa ? "" : " (mismatch)" ) << "\n";
+}
+
+// cl -EHsc -O2 -I../include 09-status_value_vector.cpp && 09-status_value_vector.exe
+// g++ -std=c++11 -O2 -Wall -I../include -o 09-status_value_vector.exe 09-status_value_vector.cpp && 09-status_value_vector.exe
+// elements: 10000000, success rate: 90%, bytes per element: AoS 16, SoA 12 + 1/8
+// sum values     : AoS 3.88198 ns, SoA 3.2662 ns per element
+// count failures : AoS 2.83648 ns, SoA 0.0744702 ns per element
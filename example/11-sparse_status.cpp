@@ -0,0 +1,81 @@
+// Memory per million results of which most succeed, with a std::string status:
+// std::vector<status_value>, status_value_vector and sparse_status_vector.
+
+#include "nonstd/status_value_batch.hpp"
+
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace nonstd;
+
+typedef std::string status;
+typedef double value;
+
+// bytes a string allocates beyond the short string buffer:
+
+std::size_t heap_bytes( std::string const & s )
+{
+    return s.capacity() > std::string().capacity() ? s.capacity() + 1 : 0;
+}
+
+void compare( std::size_t n, std::size_t failure_permille )
+{
+    std::string const failure_text( "connection reset by peer while reading the response" );
+
+    std::vector< status_value<status, value> > aos;
+    status_value_vector<status, value> soa;
+    sparse_status_vector<status, value> sparse( "ok" );
+
+    std::size_t failures = 0;
+    std::size_t status_heap = 0;
+
+    for ( std::size_t i = 0; i < n; ++i )
+    {
+        if ( i * 7919u % 1000u < failure_permille )
+        {
+            aos.push_back( status_value<status, value>( failure_text ) );
+            soa.emplace_back( failure_text );
+            sparse.push_failure( failure_text );
+
+            ++failures;
+            status_heap += heap_bytes( failure_text );
+        }
+        else
+        {
+            aos.push_back( status_value<status, value>( "ok", value( i ) ) );
+            soa.emplace_back( "ok", value( i ) );
+            sparse.emplace_value( value( i ) );
+        }
+    }
+
+    double const per_million = 1e6 / double( n ) / ( 1024 * 1024 );
+
+    double const mb_aos    = per_million * double( aos.size() * sizeof( status_value<status, value> ) + status_heap );
+    double const mb_soa    = per_million * double( soa.size() * ( sizeof( status ) + sizeof( value ) ) + soa.word_count( soa.size() ) * 8 + status_heap );
+    double const mb_sparse = per_million * double( sparse.allocated_bytes() + status_heap );
+
+    std::cout <<
+        "failures " << double( failure_permille ) / 10 << "%: " <<
+        "vector<status_value> " << mb_aos << " MB, status_value_vector " << mb_soa << " MB, " <<
+        "sparse_status_vector " << mb_sparse << " MB per million (" << sparse.count_failed() << " failures)\n";
+}
+
+int main( int argc, char * argv[] )
+{
+    std::size_t n = argc > 1 ? std::size_t( std::atol( argv[1] ) ) : 1000000u;
+
+    std::cout << "status: std::string (" << sizeof( status ) << " bytes), value: double\n";
+
+    for ( std::size_t failure_permille : { 0u, 1u, 10u, 50u } )
+        compare( n, failure_permille );
+}
+
+// cl -EHsc -O2 -I../include 11-sparse_status.cpp && 11-sparse_status.exe
+// g++ -std=c++11 -O2 -Wall -I../include -o 11-sparse_status.exe 11-sparse_status.cpp && 11-sparse_status.exe
+// status: std::string (32 bytes), value: double
+// failures 0%: vector<status_value> 45.7764 MB, status_value_vector 38.2662 MB, sparse_status_vector 8.24421 MB per million (0 failures)
+// failures 0.1%: vector<status_value> 45.826 MB, status_value_vector 38.3158 MB, sparse_status_vector 8.33286 MB per million (1000 failures)
+// failures 1%: vector<status_value> 46.2723 MB, status_value_vector 38.7621 MB, sparse_status_vector 9.36512 MB per million (10000 failures)
+// failures 5%: vector<status_value> 48.2559 MB, status_value_vector 40.7457 MB, sparse_status_vector 13.2238 MB per million (50000 failures)
@@ -0,0 +1,114 @@
+// Group a batch of results by status code, for example to retry all timeouts
+// together: a stable sort of indices by status versus group_by_status() and
+// partition_by_status(), which reorders a status_value_vector in O(n).
+
+#include "nonstd/status_value_batch.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace nonstd;
+
+enum class fetch_errc { ok, timeout, not_found, refused, reset, busy, gone, denied };
+
+struct record
+{
+    double data[4];
+};
+
+typedef status_value<fetch_errc, record> result;
+
+template< typename F >
+double ms( F f )
+{
+    auto const start = std::chrono::steady_clock::now();
+    f();
+    std::chrono::duration<double, std::milli> const elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+int main( int argc, char * argv[] )
+{
+    std::size_t n    = argc > 1 ? std::size_t( std::atol( argv[1] ) ) : 10000000u;
+    int failure_rate = argc > 2 ? std::atoi( argv[2] ) : 20;
+
+    std::vector<result> aos;
+    status_value_vector<fetch_errc, record> soa;
+    std::mt19937 gen( 42 );
+    std::uniform_int_distribution<int> percent( 0, 99 );
+    std::uniform_int_distribution<int> code( 1, 7 );
+
+    aos.reserve( n );
+    soa.reserve( n );
+
+    for ( std::size_t i = 0; i < n; ++i )
+    {
+        if ( percent( gen ) < failure_rate )
+        {
+            fetch_errc const ec = static_cast<fetch_errc>( code( gen ) );
+
+            aos.push_back( result( ec ) );
+            soa.emplace_back( ec );
+        }
+        else
+        {
+            record const r = { { double( i ) } };
+
+            aos.push_back( result( fetch_errc::ok, r ) );
+            soa.emplace_back( fetch_errc::ok, r );
+        }
+    }
+
+    std::size_t timeouts_sort = 0, timeouts_aos = 0, timeouts_soa = 0, timeouts_partition = 0;
+
+    double const t_sort = ms( [&]
+    {
+        std::vector<std::size_t> indices( n );
+
+        for ( std::size_t i = 0; i < n; ++i )
+            indices[i] = i;
+
+        std::stable_sort( indices.begin(), indices.end(), [&]( std::size_t a, std::size_t b )
+        {
+            return aos[a].status() < aos[b].status();
+        } );
+
+        timeouts_sort = std::size_t( std::count_if( indices.begin(), indices.end(), [&]( std::size_t i ) { return aos[i].status() == fetch_errc::timeout; } ) );
+    } );
+
+    double const t_aos = ms( [&]
+    {
+        timeouts_aos = group_by_status( aos, 8 ).group( fetch_errc::timeout ).size();
+    } );
+
+    double const t_soa = ms( [&]
+    {
+        timeouts_soa = group_by_status( soa, 8 ).group( fetch_errc::timeout ).size();
+    } );
+
+    double const t_partition = ms( [&]
+    {
+        timeouts_partition = partition_by_status( soa, 8 ).group( fetch_errc::timeout ).size();
+    } );
+
+    bool const same = timeouts_sort == timeouts_aos && timeouts_aos == timeouts_soa && timeouts_soa == timeouts_partition;
+
+    std::cout <<
+        "elements: " << n << ", failures: " << failure_rate << "%, timeouts: " << timeouts_sort << ( same ? "" : " (mismatch)" ) << "\n" <<
+        "stable_sort of indices        : " << t_sort      << " ms\n" <<
+        "group_by_status, vector       : " << t_aos       << " ms\n" <<
+        "group_by_status, columnar     : " << t_soa       << " ms\n" <<
+        "partition_by_status, columnar : " << t_partition << " ms (moves the values)\n";
+}
+
+// cl -EHsc -O2 -I../include 13-group_by_status.cpp && 13-group_by_status.exe
+// g++ -std=c++11 -O2 -Wall -I../include -o 13-group_by_status.exe 13-group_by_status.cpp && 13-group_by_status.exe
+// elements: 10000000, failures: 20%, timeouts: 285367
+// stable_sort of indices        : 1795.17 ms
+// group_by_status, vector       : 169.986 ms
+// group_by_status, columnar     : 99.8792 ms
+// partition_by_status, columnar : 456.947 ms (moves the values)
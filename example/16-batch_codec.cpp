@@ -0,0 +1,134 @@
+// Store a batch of results with rare, clustered failures: element by element
+// as status, engagement and value, or columnar with encode_batch(), with raw
+// or delta-encoded values, and decode it again into a status_value_vector.
+
+#include "nonstd/status_value_codec.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <system_error>
+#include <vector>
+
+using namespace nonstd;
+
+typedef status_value_vector<std::errc, std::int64_t> batch_type;
+
+template< typename F >
+double seconds( F f )
+{
+    double best = 0;
+    for ( int run = 0; run < 5; ++run )
+    {
+        auto const start = std::chrono::steady_clock::now();
+        f();
+        std::chrono::duration<double> const elapsed = std::chrono::steady_clock::now() - start;
+        best = run == 0 || elapsed.count() < best ? elapsed.count() : best;
+    }
+    return best;
+}
+
+// Element by element, in the order of the fields of a status_value:
+
+void encode_rows( batch_type const & batch, std::vector<unsigned char> & out )
+{
+    out.resize( batch.size() * ( sizeof( std::errc ) + 1 + sizeof( std::int64_t ) ) );
+    unsigned char * p = out.data();
+
+    for ( std::size_t i = 0; i < batch.size(); ++i )
+    {
+        std::errc const s = batch.status( i );
+        unsigned char const engaged = batch.has_value( i );
+        std::int64_t const v = engaged ? batch.value( i ) : 0;
+
+        std::memcpy( p, &s, sizeof s ); p += sizeof s;
+        *p++ = engaged;
+        std::memcpy( p, &v, sizeof v ); p += sizeof v;
+    }
+}
+
+void decode_rows( std::vector<unsigned char> const & in, batch_type & batch )
+{
+    std::size_t const n = in.size() / ( sizeof( std::errc ) + 1 + sizeof( std::int64_t ) );
+    unsigned char const * p = in.data();
+
+    batch.clear();
+    batch.reserve( n );
+
+    for ( std::size_t i = 0; i < n; ++i )
+    {
+        std::errc s; std::int64_t v;
+
+        std::memcpy( &s, p, sizeof s ); p += sizeof s;
+        bool const engaged = *p++ != 0;
+        std::memcpy( &v, p, sizeof v ); p += sizeof v;
+
+        if ( engaged ) batch.emplace_back( s, v );
+        else           batch.emplace_back( s );
+    }
+}
+
+int main( int argc, char * argv[] )
+{
+    std::size_t const n = argc > 1 ? std::size_t( std::atol( argv[1] ) ) : 10000000u;
+
+    // increasing timestamps, failures in bursts of up to 32 that start at 0.1% of the elements:
+
+    batch_type batch;
+    batch.reserve( n );
+
+    std::mt19937 gen( 42 );
+    std::uniform_int_distribution<int> per_mille( 0, 999 ), burst( 1, 32 ), step( 0, 1000 );
+
+    std::int64_t timestamp = 1700000000000000;
+
+    for ( std::size_t i = 0; i < n; )
+    {
+        if ( per_mille( gen ) == 0 )
+        {
+            for ( int k = burst( gen ); k > 0 && i < n; --k, ++i )
+                batch.emplace_back( std::errc::timed_out );
+        }
+        else
+        {
+            timestamp += step( gen );
+            batch.emplace_back( std::errc(), timestamp );
+            ++i;
+        }
+    }
+
+    double const gb = double( n * ( sizeof( std::errc ) + sizeof( std::int64_t ) ) ) / 1e9;
+
+    std::vector<unsigned char> rows, raw, delta;
+    batch_type decoded;
+    bool same = true;
+
+    auto check = [&]
+    {
+        for ( std::size_t i = 0; i < n; i += 997 )
+            same = same && decoded.status( i ) == batch.status( i ) && decoded.has_value( i ) == batch.has_value( i )
+                && ( ! batch.has_value( i ) || decoded.value( i ) == batch.value( i ) );
+    };
+
+    double const t_rows_enc  = seconds( [&]{ encode_rows( batch, rows ); } );
+    double const t_rows_dec  = seconds( [&]{ decode_rows( rows, decoded ); } ); check();
+    double const t_raw_enc   = seconds( [&]{ raw.clear();   encode_batch( batch, raw ); } );
+    double const t_raw_dec   = seconds( [&]{ decode_batch( raw.data(), raw.size(), decoded ); } ); check();
+    double const t_delta_enc = seconds( [&]{ delta.clear(); encode_batch( batch, delta, batch_value_encoding::delta ); } );
+    double const t_delta_dec = seconds( [&]{ decode_batch( delta.data(), delta.size(), decoded ); } ); check();
+
+    std::cout <<
+        "elements: " << n << ", failed: " << batch.count_failed() << ", statuses and values: " << 1000 * gb << " MB" << ( same ? "" : " (mismatch)" ) << "\n" <<
+        "element by element: " << rows.size()  / 1e6 << " MB, encode " << gb / t_rows_enc  << " GB/s, decode " << gb / t_rows_dec  << " GB/s\n" <<
+        "columnar, raw     : " << raw.size()   / 1e6 << " MB, encode " << gb / t_raw_enc   << " GB/s, decode " << gb / t_raw_dec   << " GB/s\n" <<
+        "columnar, delta   : " << delta.size() / 1e6 << " MB, encode " << gb / t_delta_enc << " GB/s, decode " << gb / t_delta_dec << " GB/s\n";
+}
+
+// g++ -std=c++11 -O2 -Wall -I../include -o 16-batch_codec.exe 16-batch_codec.cpp && 16-batch_codec.exe
+// elements: 10000000, failed: 164747, statuses and values: 120 MB
+// element by element: 130 MB, encode 5.28922 GB/s, decode 2.36818 GB/s
+// columnar, raw     : 79.9847 MB, encode 6.23958 GB/s, decode 4.80816 GB/s
+// columnar, delta   : 14.903 MB, encode 2.73975 GB/s, decode 2.69467 GB/s
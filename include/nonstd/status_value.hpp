@@ -48,6 +48,30 @@
 # endif
 #endif
 
+// Number of blocks freelist_box_pool<> keeps per type and thread for reuse:
+
+#ifndef  nsstsv_CONFIG_BOX_POOL_MAX_CACHED
+# define nsstsv_CONFIG_BOX_POOL_MAX_CACHED  64
+#endif
+
+// Size of the inline payload buffer of payload_status:
+
+#ifndef  nsstsv_CONFIG_PAYLOAD_INLINE_SIZE
+# define nsstsv_CONFIG_PAYLOAD_INLINE_SIZE  32
+#endif
+
+// Number of characters a context frame of context_status can copy:
+
+#ifndef  nsstsv_CONFIG_CONTEXT_TEXT_SIZE
+# define nsstsv_CONFIG_CONTEXT_TEXT_SIZE  24
+#endif
+
+// Disable the SIMD batch kernels and their run-time dispatch:
+
+#ifndef  nsstsv_CONFIG_NO_SIMD
+# define nsstsv_CONFIG_NO_SIMD  0
+#endif
+
 // C++ language version detection (C++23 is speculative):
 // Note: VC14.0/1900 (VS2015) lacks too much from C++14.
 
@@ -81,6 +105,45 @@
 #define nsstsv_HAVE_NOEXCEPT       nsstsv_CPP11_140
 #define nsstsv_HAVE_NORETURN     ( nsstsv_CPP11_140 && ! nsstsv_BETWEEN( nsstsv_COMPILER_GNUC_VERSION, 1, 480 ) )
 
+// Presence of C++ library features:
+
+#define nsstsv_HAVE_STRING_VIEW    nsstsv_CPP17_000
+#define nsstsv_HAVE_STD_OPTIONAL   nsstsv_CPP17_000
+
+#if nsstsv_CPP20_OR_GREATER
+# include <version>
+#endif
+
+#if defined(__cpp_lib_bitops) && __cpp_lib_bitops >= 201907L
+# define nsstsv_HAVE_STD_POPCOUNT  1
+#else
+# define nsstsv_HAVE_STD_POPCOUNT  0
+#endif
+
+#if ! nsstsv_CONFIG_NO_SIMD && ( defined(__x86_64__) || defined(__i386__) ) && defined(__GNUC__)
+# define nsstsv_HAVE_X86_SIMD_DISPATCH  1
+#else
+# define nsstsv_HAVE_X86_SIMD_DISPATCH  0
+#endif
+
+#if defined(__cpp_lib_expected) && __cpp_lib_expected >= 202202L
+# define nsstsv_HAVE_STD_EXPECTED  1
+#else
+# define nsstsv_HAVE_STD_EXPECTED  0
+#endif
+
+#if defined(__cpp_lib_ranges) && __cpp_lib_ranges >= 201911L
+# define nsstsv_HAVE_STD_RANGES  1
+#else
+# define nsstsv_HAVE_STD_RANGES  0
+#endif
+
+#if defined(__cpp_lib_ranges) && __cpp_lib_ranges >= 202202L
+# define nsstsv_HAVE_RANGE_ADAPTOR_CLOSURE  1
+#else
+# define nsstsv_HAVE_RANGE_ADAPTOR_CLOSURE  0
+#endif
+
 #if nsstsv_HAVE_CONSTEXPR_14
 # define nsstsv_constexpr14 constexpr
 #else
@@ -103,6 +166,30 @@
 
 #if ! nsstsv_CONFIG_NO_EXCEPTIONS
 # include <stdexcept>
+#else
+# include <cstdlib>     // for std::abort()
+#endif
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iosfwd>
+#include <memory>
+#include <new>
+#include <tuple>
+#include <type_traits>
+
+#if nsstsv_HAVE_STD_OPTIONAL
+# include <optional>
+#endif
+
+#if nsstsv_HAVE_STD_EXPECTED
+# include <expected>
+#endif
+
+#if nsstsv_HAVE_STRING_VIEW
+# include <string_view>
 #endif
 
 namespace nonstd {
@@ -112,276 +199,3307 @@ class status_value;
 
 namespace status_value_detail {
 
-// Union to hold value:
+struct unchecked_access;
 
-template< typename S, typename V >
-union storage_t
+} // namespace status_value_detail
+
+namespace status_value_detail {
+
+// Storage for a block of n objects of type T, also if T is over-aligned:
+
+#if defined(__cpp_aligned_new)
+
+template< typename T >
+void * allocate_block( std::size_t n = 1 )
 {
-    friend class status_value<S,V>;
+    return alignof( T ) > __STDCPP_DEFAULT_NEW_ALIGNMENT__
+        ? ::operator new( n * sizeof( T ), std::align_val_t( alignof( T ) ) )
+        : ::operator new( n * sizeof( T ) );
+}
 
-private:
-    typedef V value_type;
+template< typename T >
+void deallocate_block( void * p ) nsstsv_noexcept
+{
+    if ( alignof( T ) > __STDCPP_DEFAULT_NEW_ALIGNMENT__ )
+        ::operator delete( p, std::align_val_t( alignof( T ) ) );
+    else
+        ::operator delete( p );
+}
 
-    // no-op construction
-    storage_t() nsstsv_noexcept {}
-    ~storage_t() {}
+#else // __cpp_aligned_new
 
-    void construct_value( value_type const & v )
-    {
-        new( &m_value ) value_type( v );
-    }
+// over-allocate and keep the pointer to release in front of the aligned block:
 
-    void construct_value( value_type && v )
-    {
-        new( &m_value ) value_type( std::move( v ) );
-    }
+template< typename T >
+void * allocate_block( std::size_t n = 1 )
+{
+    if ( alignof( T ) <= alignof( std::max_align_t ) )
+        return ::operator new( n * sizeof( T ) );
 
-    void destruct_value() nsstsv_noexcept
-    {
-        m_value.~value_type();
-    }
+    void * raw = ::operator new( n * sizeof( T ) + alignof( T ) );
+    std::uintptr_t const aligned = ( reinterpret_cast<std::uintptr_t>( raw ) + alignof( T ) ) & ~std::uintptr_t( alignof( T ) - 1 );
 
-    constexpr value_type const & value() const & nsstsv_noexcept
-    {
-        return m_value;
-    }
+    reinterpret_cast<void **>( aligned )[-1] = raw;
+    return reinterpret_cast<void *>( aligned );
+}
 
-    value_type & value() & nsstsv_noexcept
-    {
-        return m_value;
-    }
+template< typename T >
+void deallocate_block( void * p ) nsstsv_noexcept
+{
+    if ( alignof( T ) <= alignof( std::max_align_t ) )
+        ::operator delete( p );
+    else
+        ::operator delete( static_cast<void **>( p )[-1] );
+}
 
-    constexpr value_type const && value() const &&
-    {
-        return std::move( m_value );
-    }
+#endif // __cpp_aligned_new
 
-    value_type && value() &&
-    {
-        return std::move( m_value );
-    }
+} // namespace status_value_detail
 
-    value_type const * value_ptr() const  nsstsv_noexcept
+// Pools to allocate out-of-line status details and values from.
+//
+// A pool is a class template on the block type with static member functions
+//     static void * allocate();
+//     static void deallocate( void * p ) noexcept;
+// that provide and release storage for a single block.
+
+template< typename T >
+struct heap_box_pool
+{
+    static void * allocate()
     {
-        return &m_value;
+        return status_value_detail::allocate_block<T>();
     }
 
-    value_type * value_ptr() nsstsv_noexcept
+    static void deallocate( void * p ) nsstsv_noexcept
     {
-        return &m_value;
+        status_value_detail::deallocate_block<T>( p );
     }
-
-private:
-    value_type m_value;
 };
 
-} // namespace status_value_detail
-
-#if nsstsv_CONFIG_NO_EXCEPTIONS
-
-// Note: std::terminate() requires header <exception>.
+// Keeps up to nsstsv_CONFIG_BOX_POOL_MAX_CACHED released blocks per thread for reuse:
 
-template< typename S >
-nsstsv_noreturn inline void report_bad_status_value_access( S && /*status*/ ) nsstsv_noexcept
+template< typename T >
+struct freelist_box_pool
 {
-    std::abort();
-}
+    static void * allocate()
+    {
+        free_list & list = blocks();
 
-#else // nsstsv_CONFIG_NO_EXCEPTIONS
+        if ( list.head == nullptr )
+            return status_value_detail::allocate_block<block>();
 
-// Exception type to throw on unengaged access:
+        block * b = list.head;
+        list.head = b->next;
+        --list.size;
+        return b;
+    }
 
-template< typename S >
-class bad_status_value_access : public std::logic_error
-{
-public:
-  // constructors
-  bad_status_value_access() = delete;
+    static void deallocate( void * p ) nsstsv_noexcept
+    {
+        free_list & list = blocks();
 
-  bad_status_value_access( S s )
-  : std::logic_error( "status_value: bad status_value access" )
-  , m_status( std::move( s ) )
-  {}
+        if ( list.size >= nsstsv_CONFIG_BOX_POOL_MAX_CACHED )
+        {
+            status_value_detail::deallocate_block<block>( p );
+            return;
+        }
 
-  // destructor
-  // ~bad_status_value_access() nsstsv_override {}
+        block * b = ::new( p ) block;
+        b->next = list.head;
+        list.head = b;
+        ++list.size;
+    }
 
-  // status observers
-  S const & status() const nsstsv_noexcept
-  {
-      return m_status;
-  }
+    static std::size_t cached() nsstsv_noexcept
+    {
+        return blocks().size;
+    }
 
 private:
-    S m_status;
-};
+    union block
+    {
+        block * next;
+        alignas( T ) unsigned char storage[ sizeof(T) ];
+    };
 
-template< typename S >
-nsstsv_noreturn inline void report_bad_status_value_access( S && status )
-{
-    throw bad_status_value_access<typename std::remove_reference<S>::type>( std::forward<S>( status ) );
-}
+    struct free_list
+    {
+        block * head = nullptr;
+        std::size_t size = 0;
 
-#endif // nsstsv_CONFIG_NO_EXCEPTIONS
+        ~free_list()
+        {
+            while ( head != nullptr )
+            {
+                block * b = head;
+                head = b->next;
+                status_value_detail::deallocate_block<block>( b );
+            }
+        }
+    };
 
-// Status and optional value:
-//
-// Status shall be an object type and shall be copy constructible and destructible.
-// Value shall be an object type and shall be move constructible and destructible.
+    static free_list & blocks() nsstsv_noexcept
+    {
+        static thread_local free_list list;
+        return list;
+    }
+};
 
-template< typename S, typename V >
-class status_value
+// Monotonic arena to allocate from within a scope, such as a request.
+// An arena belongs to the thread that creates it: only that thread allocates
+// from it. Blocks from it may be released on any thread, see arena_box_pool<>.
+
+class box_arena
 {
 public:
-    typedef S status_type;
-    typedef V value_type;
-
-    // ?.?.3.1 constructors
+    box_arena( void * buffer, std::size_t size ) nsstsv_noexcept
+    : m_begin( static_cast<unsigned char *>( buffer ) )
+    , m_size( size )
+    , m_used( 0 )
+    {}
 
-    status_value() = delete;
+    box_arena( box_arena const & ) = delete;
+    box_arena & operator=( box_arena const & ) = delete;
 
-    status_value( status_type s )
-    : m_status( std::move( s ) )
-    , m_has_value( false )
-    {}
+    // storage for size bytes, or nullptr if the arena is exhausted:
 
-    status_value( status_type s, value_type const & v )
-    : m_status( std::move( s ) )
-    , m_has_value( true )
+    void * allocate( std::size_t size, std::size_t align ) nsstsv_noexcept
     {
-        contained.construct_value( v );
+        std::uintptr_t const base  = reinterpret_cast<std::uintptr_t>( m_begin );
+        std::uintptr_t const first = ( base + m_used + align - 1 ) & ~std::uintptr_t( align - 1 );
+
+        if ( first + size > base + m_size )
+            return nullptr;
+
+        m_used = first + size - base;
+        return m_begin + ( first - base );
     }
 
-    status_value( status_type s, value_type && v )
-    : m_status( std::move( s ) )
-    , m_has_value( true )
+    bool owns( void const * p ) const nsstsv_noexcept
     {
-        contained.construct_value( std::move( v ) );
+        unsigned char const * q = static_cast<unsigned char const *>( p );
+        return m_begin <= q && q < m_begin + m_size;
     }
 
-    status_value( status_value && other )
-    : m_status   ( std::move( other.m_status ) )
-    , m_has_value( other.m_has_value )
+    // release all allocations at once:
+
+    void release() nsstsv_noexcept
     {
-        if ( other.m_has_value )
-        {
-            contained.construct_value( std::move( other.contained.value() ) );
-            other.contained.destruct_value();
-            other.m_has_value = false;
-        }
+        m_used = 0;
     }
 
-    // ?.?.3.2 destructor
+    std::size_t used() const nsstsv_noexcept
+    {
+        return m_used;
+    }
 
-    ~status_value()
+    std::size_t size() const nsstsv_noexcept
     {
-        if ( m_has_value )
-        {
-            contained.destruct_value();
-        }
+        return m_size;
     }
 
-    // assignment
+    // innermost arena in scope for this thread, or nullptr:
 
-    status_value & operator=( status_value const & ) = delete;
+    static box_arena * current() nsstsv_noexcept
+    {
+        return current_ref();
+    }
 
-    // ?.?.3.3 status observers
+private:
+    friend class box_arena_scope;
 
-    status_type const & status() const nsstsv_noexcept
+    static box_arena *& current_ref() nsstsv_noexcept
     {
-        return m_status;
+        static thread_local box_arena * arena = nullptr;
+        return arena;
     }
 
-    // ?.?.3.4 state observers
+    unsigned char * m_begin;
+    std::size_t m_size;
+    std::size_t m_used;
+};
 
-    constexpr bool has_value() const nsstsv_noexcept
+// Make arena the current arena of this thread for the lifetime of the scope.
+// Scopes nest, also on the same arena:
+
+class box_arena_scope
+{
+public:
+    explicit box_arena_scope( box_arena & arena ) nsstsv_noexcept
+    : m_previous( box_arena::current_ref() )
     {
-        return m_has_value;
+        box_arena::current_ref() = &arena;
     }
 
-    constexpr explicit operator bool() const nsstsv_noexcept
+    ~box_arena_scope()
     {
-        return has_value();
+        box_arena::current_ref() = m_previous;
     }
 
-    // ?.?.3.5 value observers
+    box_arena_scope( box_arena_scope const & ) = delete;
+    box_arena_scope & operator=( box_arena_scope const & ) = delete;
 
-    value_type const & value() const &
-    {
-        if ( ! has_value() )
-            report_bad_status_value_access( m_status );
+private:
+    box_arena * m_previous;
+};
 
-        return contained.value();
-    }
+// Allocates from the current arena while one is in scope and has room, else from the heap.
+// Each block records where it came from, so that it is released correctly on any
+// thread, at the cost of alignof(T) bytes. Blocks from an arena are released with
+// the arena and must not outlive the arena; they may be destroyed after its scope ends.
 
-    value_type & value() &
+template< typename T >
+struct arena_box_pool
+{
+    static void * allocate()
     {
-        if ( ! has_value() )
-            report_bad_status_value_access( m_status );
-
-        return contained.value();
+        if ( box_arena * arena = box_arena::current() )
+        {
+            if ( void * p = arena->allocate( sizeof( block ), alignof( block ) ) )
+                return ::new( p ) block( true );
+        }
+        return ::new( status_value_detail::allocate_block<block>() ) block( false );
     }
 
-    value_type && value() &&
+    static void deallocate( void * p ) nsstsv_noexcept
     {
-        if ( ! has_value() )
-            report_bad_status_value_access( std::move( m_status ) );
+        block * b = static_cast<block *>( p );
 
-        return std::move( contained ).value();
+        if ( ! b->from_arena )
+            status_value_detail::deallocate_block<block>( b );
     }
 
-    value_type const && value() const &&
+private:
+    struct block
     {
-        if ( ! has_value() )
-            report_bad_status_value_access( std::move( m_status ) );
+        explicit block( bool from_arena_ ) nsstsv_noexcept
+        : from_arena( from_arena_ )
+        {}
 
-        return std::move( contained ).value();
-    }
+        alignas( T ) unsigned char storage[ sizeof(T) ];
+        bool from_arena;
+    };
 
-    value_type const * operator->() const
-    {
-        if ( ! has_value() )
-            report_bad_status_value_access( m_status );
+public:
+    // block taken from an arena or the heap per value:
 
-        return contained.value_ptr();
-    }
+    typedef block block_type;
+};
 
-    value_type * operator->()
-    {
-        if ( ! has_value() )
-            report_bad_status_value_access( m_status );
+// Tag to construct the value of status_value from the result of a callable:
 
-        return contained.value_ptr();
-    }
+struct from_invoke_t
+{
+    explicit from_invoke_t() = default;
+};
 
-    value_type const & operator *() const &
-    {
-        return value();
+constexpr from_invoke_t from_invoke{};
+
+namespace status_value_detail {
+
+// Uses-allocator construction: with leading allocator_arg_t and allocator,
+// with trailing allocator, or without allocator if T does not use Alloc:
+
+template< int Kind >
+using uses_allocator_kind = std::integral_constant<int, Kind>;
+
+template< typename T, typename Alloc, typename... Args >
+using uses_allocator_construction = uses_allocator_kind<
+    ! std::uses_allocator<T, Alloc>::value ? 0
+    : std::is_constructible<T, std::allocator_arg_t, Alloc const &, Args...>::value ? 1 : 2 >;
+
+template< typename T, typename Alloc, typename... Args >
+struct is_constructible_using_allocator : std::integral_constant< bool,
+    std::is_constructible<T, Args...>::value
+    || ( std::uses_allocator<T, Alloc>::value
+        && ( std::is_constructible<T, std::allocator_arg_t, Alloc const &, Args...>::value
+            || std::is_constructible<T, Args..., Alloc const &>::value ) ) > {};
+
+template< typename T, typename Alloc, typename... Args >
+void construct_using_allocator( uses_allocator_kind<0>, void * p, Alloc const &, Args&&... args )
+{
+    ::new( p ) T( std::forward<Args>( args )... );
+}
+
+template< typename T, typename Alloc, typename... Args >
+void construct_using_allocator( uses_allocator_kind<1>, void * p, Alloc const & alloc, Args&&... args )
+{
+    ::new( p ) T( std::allocator_arg, alloc, std::forward<Args>( args )... );
+}
+
+template< typename T, typename Alloc, typename... Args >
+void construct_using_allocator( uses_allocator_kind<2>, void * p, Alloc const & alloc, Args&&... args )
+{
+    ::new( p ) T( std::forward<Args>( args )..., alloc );
+}
+
+template< typename T, typename Alloc, typename... Args >
+void construct_using_allocator( void * p, Alloc const & alloc, Args&&... args )
+{
+    construct_using_allocator<T>( uses_allocator_construction<T, Alloc, Args...>(), p, alloc, std::forward<Args>( args )... );
+}
+
+// Invoke f with args, yielding its prvalue result, which C++17 guarantees to elide;
+// std::apply() invokes like std::invoke() without requiring <functional>:
+
+#if nsstsv_CPP17_000
+
+template< typename F, typename... Args >
+using invoke_result_t = std::invoke_result_t<F, Args...>;
+
+template< typename F, typename... Args >
+invoke_result_t<F, Args...> invoke( F && f, Args&&... args )
+{
+    return std::apply( std::forward<F>( f ), std::forward_as_tuple( std::forward<Args>( args )... ) );
+}
+
+#else // nsstsv_CPP17_000
+
+template< typename F, typename... Args >
+using invoke_result_t = decltype( std::declval<F>()( std::declval<Args>()... ) );
+
+template< typename F, typename... Args >
+invoke_result_t<F, Args...> invoke( F && f, Args&&... args )
+{
+    return std::forward<F>( f )( std::forward<Args>( args )... );
+}
+
+#endif // nsstsv_CPP17_000
+
+// Narrowing: an arithmetic conversion that list-initialization rejects:
+
+template< typename From, typename To, typename = void >
+struct is_list_convertible : std::false_type {};
+
+template< typename From, typename To >
+struct is_list_convertible< From, To, decltype( void( To{ std::declval<From>() } ) ) > : std::true_type {};
+
+template< typename From, typename To >
+struct is_narrowing : std::integral_constant< bool,
+    std::is_arithmetic< typename std::decay<From>::type >::value
+    && std::is_arithmetic<To>::value && ! is_list_convertible<From, To>::value > {};
+
+template< typename From, typename To >
+struct is_implicitly_convertible : std::integral_constant< bool,
+    std::is_convertible<From, To>::value && ! is_narrowing<From, To>::value > {};
+
+// Explicit conversion, static_cast for arithmetic types, without temporary otherwise:
+
+template< typename To, typename From >
+typename std::enable_if< std::is_arithmetic<To>::value, To >::type
+convert_explicitly( From && from )
+{
+    return static_cast<To>( from );
+}
+
+template< typename To, typename From >
+typename std::enable_if< ! std::is_arithmetic<To>::value, From && >::type
+convert_explicitly( From && from )
+{
+    return std::forward<From>( from );
+}
+
+// Conversion of status_value<S2, V2> to status_value<S, V> from status SArg and value VArg:
+
+template< typename S, typename V, typename SArg, typename VArg >
+struct is_status_value_constructible : std::integral_constant< bool,
+    std::is_constructible<S, SArg>::value && std::is_constructible<V, VArg>::value > {};
+
+template< typename S, typename V, typename SArg, typename VArg >
+struct is_status_value_convertible : std::integral_constant< bool,
+    is_implicitly_convertible<SArg, S>::value && is_implicitly_convertible<VArg, V>::value > {};
+
+// Union to hold value:
+
+template< typename S, typename V >
+union storage_t
+{
+    template< typename S2, typename V2 >
+    friend class nonstd::status_value;
+
+    friend struct unchecked_access;
+
+private:
+    typedef V value_type;
+
+    // no-op construction
+    storage_t() nsstsv_noexcept {}
+    ~storage_t() {}
+
+    void construct_value( value_type const & v )
+    {
+        new( &m_value ) value_type( v );
+    }
+
+    void construct_value( value_type && v )
+    {
+        new( &m_value ) value_type( std::move( v ) );
+    }
+
+    template< typename Alloc, typename... Args >
+    void construct_value_using_allocator( Alloc const & alloc, Args&&... args )
+    {
+        construct_using_allocator<value_type>( &m_value, alloc, std::forward<Args>( args )... );
+    }
+
+    template< typename F, typename... Args >
+    void construct_value_from( F && f, Args&&... args )
+    {
+        ::new( &m_value ) value_type( status_value_detail::invoke( std::forward<F>( f ), std::forward<Args>( args )... ) );
+    }
+
+    template< typename... Args >
+    void emplace_value( Args&&... args )
+    {
+        ::new( &m_value ) value_type( std::forward<Args>( args )... );
+    }
+
+    void move_value_from( storage_t & other )
+    {
+        construct_value( std::move( other.m_value ) );
+        other.destruct_value();
+    }
+
+    void destruct_value() nsstsv_noexcept
+    {
+        m_value.~value_type();
+    }
+
+    constexpr value_type const & value() const & nsstsv_noexcept
+    {
+        return m_value;
+    }
+
+    value_type & value() & nsstsv_noexcept
+    {
+        return m_value;
+    }
+
+    constexpr value_type const && value() const &&
+    {
+        return std::move( m_value );
+    }
+
+    value_type && value() &&
+    {
+        return std::move( m_value );
+    }
+
+    value_type const * value_ptr() const  nsstsv_noexcept
+    {
+        return &m_value;
+    }
+
+    value_type * value_ptr() nsstsv_noexcept
+    {
+        return &m_value;
+    }
+
+private:
+    value_type m_value;
+};
+
+} // namespace status_value_detail
+
+// Out-of-line value storage for status_value<S, boxed_value<V, Pool>>:
+
+template< typename V, template< typename > class Pool = heap_box_pool >
+struct boxed_value
+{
+    typedef V value_type;
+};
+
+namespace status_value_detail {
+
+// Return block to pool unless released:
+
+template< template< typename > class Pool, typename Node >
+struct box_block_guard
+{
+    void * block;
+
+    ~box_block_guard()
+    {
+        if ( block != nullptr )
+            Pool<Node>::deallocate( block );
+    }
+};
+
+// Pointer to value allocated from Pool:
+
+template< typename S, typename V, template< typename > class Pool >
+class boxed_storage_t
+{
+    template< typename S2, typename V2 >
+    friend class nonstd::status_value;
+
+    friend struct unchecked_access;
+
+private:
+    typedef V value_type;
+
+    boxed_storage_t() nsstsv_noexcept
+    : m_ptr( nullptr )
+    {}
+
+    void construct_value( value_type const & v )
+    {
+        m_ptr = create( v );
+    }
+
+    void construct_value( value_type && v )
+    {
+        m_ptr = create( std::move( v ) );
+    }
+
+    template< typename Alloc, typename... Args >
+    void construct_value_using_allocator( Alloc const & alloc, Args&&... args )
+    {
+        box_block_guard<Pool, value_type> guard = { Pool<value_type>::allocate() };
+
+        construct_using_allocator<value_type>( guard.block, alloc, std::forward<Args>( args )... );
+        m_ptr = static_cast<value_type *>( guard.block );
+        guard.block = nullptr;
+    }
+
+    template< typename F, typename... Args >
+    void construct_value_from( F && f, Args&&... args )
+    {
+        box_block_guard<Pool, value_type> guard = { Pool<value_type>::allocate() };
+
+        m_ptr = ::new( guard.block ) value_type( status_value_detail::invoke( std::forward<F>( f ), std::forward<Args>( args )... ) );
+        guard.block = nullptr;
+    }
+
+    template< typename... Args >
+    void emplace_value( Args&&... args )
+    {
+        m_ptr = create( std::forward<Args>( args )... );
+    }
+
+    void move_value_from( boxed_storage_t & other ) nsstsv_noexcept
+    {
+        m_ptr = other.m_ptr;
+        other.m_ptr = nullptr;
+    }
+
+    void destruct_value() nsstsv_noexcept
+    {
+        m_ptr->~value_type();
+        Pool<value_type>::deallocate( m_ptr );
+        m_ptr = nullptr;
+    }
+
+    value_type const & value() const & nsstsv_noexcept
+    {
+        return *m_ptr;
+    }
+
+    value_type & value() & nsstsv_noexcept
+    {
+        return *m_ptr;
+    }
+
+    value_type const && value() const &&
+    {
+        return std::move( *m_ptr );
+    }
+
+    value_type && value() &&
+    {
+        return std::move( *m_ptr );
+    }
+
+    value_type const * value_ptr() const nsstsv_noexcept
+    {
+        return m_ptr;
+    }
+
+    value_type * value_ptr() nsstsv_noexcept
+    {
+        return m_ptr;
+    }
+
+private:
+    template< typename... Args >
+    static value_type * create( Args&&... args )
+    {
+        box_block_guard<Pool, value_type> guard = { Pool<value_type>::allocate() };
+
+        value_type * p = ::new( guard.block ) value_type( std::forward<Args>( args )... );
+        guard.block = nullptr;
+        return p;
+    }
+
+    value_type * m_ptr;
+};
+
+// Select value type and storage of status_value<S, V>:
+
+template< typename S, typename V >
+struct storage_of
+{
+    typedef V value_type;
+    typedef storage_t<S, V> type;
+};
+
+template< typename S, typename V, template< typename > class Pool >
+struct storage_of< S, boxed_value<V, Pool> >
+{
+    typedef V value_type;
+    typedef boxed_storage_t<S, V, Pool> type;
+};
+
+} // namespace status_value_detail
+
+#if nsstsv_CONFIG_NO_EXCEPTIONS
+
+// Note: std::terminate() requires header <exception>.
+
+template< typename S >
+nsstsv_noreturn inline void report_bad_status_value_access( S && /*status*/ ) nsstsv_noexcept
+{
+    std::abort();
+}
+
+#else // nsstsv_CONFIG_NO_EXCEPTIONS
+
+// Exception type to throw on unengaged access:
+
+template< typename S >
+class bad_status_value_access : public std::logic_error
+{
+public:
+  // constructors
+  bad_status_value_access() = delete;
+
+  bad_status_value_access( S s )
+  : std::logic_error( "status_value: bad status_value access" )
+  , m_status( std::move( s ) )
+  {}
+
+  // destructor
+  // ~bad_status_value_access() nsstsv_override {}
+
+  // status observers
+  S const & status() const nsstsv_noexcept
+  {
+      return m_status;
+  }
+
+private:
+    S m_status;
+};
+
+template< typename S >
+nsstsv_noreturn inline void report_bad_status_value_access( S && status )
+{
+    throw bad_status_value_access<typename std::remove_reference<S>::type>( std::forward<S>( status ) );
+}
+
+#endif // nsstsv_CONFIG_NO_EXCEPTIONS
+
+// Status and optional value:
+//
+// Status shall be an object type and shall be copy constructible and destructible.
+// Value shall be an object type and shall be move constructible and destructible.
+
+template< typename S, typename V >
+class status_value
+{
+public:
+    typedef S status_type;
+    typedef typename status_value_detail::storage_of<S, V>::value_type value_type;
+
+    // ?.?.3.1 constructors
+
+    status_value() = delete;
+
+    status_value( status_type s )
+    : m_status( std::move( s ) )
+    , m_has_value( false )
+    {}
+
+    status_value( status_type s, value_type const & v )
+    : m_status( std::move( s ) )
+    , m_has_value( true )
+    {
+        contained.construct_value( v );
+    }
+
+    status_value( status_type s, value_type && v )
+    : m_status( std::move( s ) )
+    , m_has_value( true )
+    {
+        contained.construct_value( std::move( v ) );
+    }
+
+    status_value( status_value && other )
+    : m_status   ( std::move( other.m_status ) )
+    , m_has_value( other.m_has_value )
+    {
+        if ( other.m_has_value )
+        {
+            contained.move_value_from( other.contained );
+            other.m_has_value = false;
+        }
+    }
+
+    // construct the value in place from the result of f( args... ),
+    // without moving it in C++17 and later
+
+    template< typename F, typename... Args >
+    status_value( status_type s, from_invoke_t, F && f, Args&&... args )
+    : m_status( std::move( s ) )
+    , m_has_value( true )
+    {
+        contained.construct_value_from( std::forward<F>( f ), std::forward<Args>( args )... );
+    }
+
+    // converting constructors: convert status and value of other straight into this;
+    // explicit if a conversion is explicit or narrowing
+
+    template< typename S2, typename V2
+        , typename VArg = typename std::add_lvalue_reference< typename status_value<S2, V2>::value_type const >::type
+        , typename std::enable_if<
+            ! std::is_same< status_value<S2, V2>, status_value >::value
+            && ! std::is_void< typename status_value<S2, V2>::value_type >::value
+            && status_value_detail::is_status_value_constructible<S, value_type, S2 const &, VArg>::value
+            && status_value_detail::is_status_value_convertible  <S, value_type, S2 const &, VArg>::value, int >::type = 0
+    >
+    status_value( status_value<S2, V2> const & other )
+    : m_status( other.status() )
+    , m_has_value( other.has_value() )
+    {
+        if ( other.has_value() )
+            contained.emplace_value( *other );
+    }
+
+    template< typename S2, typename V2
+        , typename VArg = typename std::add_lvalue_reference< typename status_value<S2, V2>::value_type const >::type
+        , typename std::enable_if<
+            ! std::is_same< status_value<S2, V2>, status_value >::value
+            && ! std::is_void< typename status_value<S2, V2>::value_type >::value
+            && status_value_detail::is_status_value_constructible<S, value_type, S2 const &, VArg>::value
+            && ! status_value_detail::is_status_value_convertible<S, value_type, S2 const &, VArg>::value, int >::type = 0
+    >
+    explicit status_value( status_value<S2, V2> const & other )
+    : m_status( status_value_detail::convert_explicitly<status_type>( other.status() ) )
+    , m_has_value( other.has_value() )
+    {
+        if ( other.has_value() )
+            contained.emplace_value( status_value_detail::convert_explicitly<value_type>( *other ) );
+    }
+
+    template< typename S2, typename V2
+        , typename VArg = typename status_value<S2, V2>::value_type &&
+        , typename std::enable_if<
+            ! std::is_same< status_value<S2, V2>, status_value >::value
+            && std::is_object< V2 >::value
+            && status_value_detail::is_status_value_constructible<S, value_type, S2 &&, VArg>::value
+            && status_value_detail::is_status_value_convertible  <S, value_type, S2 &&, VArg>::value, int >::type = 0
+    >
+    status_value( status_value<S2, V2> && other )
+    : m_status( std::move( other.m_status ) )
+    , m_has_value( other.m_has_value )
+    {
+        move_converted_value_from( other );
+    }
+
+    template< typename S2, typename V2
+        , typename VArg = typename status_value<S2, V2>::value_type &&
+        , typename std::enable_if<
+            ! std::is_same< status_value<S2, V2>, status_value >::value
+            && std::is_object< V2 >::value
+            && status_value_detail::is_status_value_constructible<S, value_type, S2 &&, VArg>::value
+            && ! status_value_detail::is_status_value_convertible<S, value_type, S2 &&, VArg>::value, int >::type = 0
+    >
+    explicit status_value( status_value<S2, V2> && other )
+    : m_status( status_value_detail::convert_explicitly<status_type>( std::move( other.m_status ) ) )
+    , m_has_value( other.m_has_value )
+    {
+        if ( other.m_has_value )
+        {
+            contained.emplace_value( status_value_detail::convert_explicitly<value_type>( std::move( other.contained ).value() ) );
+            other.contained.destruct_value();
+            other.m_has_value = false;
+        }
+    }
+
+    // allocator-extended constructors: uses-allocator construction of status and value,
+    // the status straight from its argument
+
+    template< typename Alloc, typename SArg
+        , typename std::enable_if<
+            status_value_detail::is_constructible_using_allocator< S, Alloc, SArg >::value
+            && ! std::is_same< typename std::decay<SArg>::type, status_value >::value, int >::type = 0
+    >
+    status_value( std::allocator_arg_t, Alloc const & alloc, SArg && s )
+    : status_value( status_value_detail::uses_allocator_construction<S, Alloc, SArg>(), alloc, std::forward<SArg>( s ) )
+    {}
+
+    template< typename Alloc, typename SArg
+        , typename std::enable_if< status_value_detail::is_constructible_using_allocator< S, Alloc, SArg >::value, int >::type = 0
+    >
+    status_value( std::allocator_arg_t, Alloc const & alloc, SArg && s, value_type const & v )
+    : status_value( status_value_detail::uses_allocator_construction<S, Alloc, SArg>(), alloc, std::forward<SArg>( s ) )
+    {
+        contained.construct_value_using_allocator( alloc, v );
+        m_has_value = true;
+    }
+
+    template< typename Alloc, typename SArg
+        , typename std::enable_if< status_value_detail::is_constructible_using_allocator< S, Alloc, SArg >::value, int >::type = 0
+    >
+    status_value( std::allocator_arg_t, Alloc const & alloc, SArg && s, value_type && v )
+    : status_value( status_value_detail::uses_allocator_construction<S, Alloc, SArg>(), alloc, std::forward<SArg>( s ) )
+    {
+        contained.construct_value_using_allocator( alloc, std::move( v ) );
+        m_has_value = true;
+    }
+
+    // move status and value to storage of alloc; this copies if their allocators differ
+
+    template< typename Alloc >
+    status_value( std::allocator_arg_t, Alloc const & alloc, status_value && other )
+    : status_value( status_value_detail::uses_allocator_construction<S, Alloc, S &&>(), alloc, std::move( other.m_status ) )
+    {
+        if ( other.m_has_value )
+        {
+            contained.construct_value_using_allocator( alloc, std::move( other.contained ).value() );
+            m_has_value = true;
+            other.contained.destruct_value();
+            other.m_has_value = false;
+        }
+    }
+
+    // ?.?.3.2 destructor
+
+    ~status_value()
+    {
+        if ( m_has_value )
+        {
+            contained.destruct_value();
+        }
+    }
+
+    // assignment
+
+    status_value & operator=( status_value const & ) = delete;
+
+    // ?.?.3.3 status observers
+
+    status_type const & status() const & nsstsv_noexcept
+    {
+        return m_status;
+    }
+
+    status_type && status() && nsstsv_noexcept
+    {
+        return std::move( m_status );
+    }
+
+    // ?.?.3.4 state observers
+
+    constexpr bool has_value() const nsstsv_noexcept
+    {
+        return m_has_value;
+    }
+
+    constexpr explicit operator bool() const nsstsv_noexcept
+    {
+        return has_value();
+    }
+
+    // ?.?.3.5 value observers
+
+    value_type const & value() const &
+    {
+        if ( ! has_value() )
+            report_bad_status_value_access( m_status );
+
+        return contained.value();
+    }
+
+    value_type & value() &
+    {
+        if ( ! has_value() )
+            report_bad_status_value_access( m_status );
+
+        return contained.value();
+    }
+
+    value_type && value() &&
+    {
+        if ( ! has_value() )
+            report_bad_status_value_access( std::move( m_status ) );
+
+        return std::move( contained ).value();
+    }
+
+    value_type const && value() const &&
+    {
+        if ( ! has_value() )
+            report_bad_status_value_access( std::move( m_status ) );
+
+        return std::move( contained ).value();
+    }
+
+    value_type const * operator->() const
+    {
+        if ( ! has_value() )
+            report_bad_status_value_access( m_status );
+
+        return contained.value_ptr();
+    }
+
+    value_type * operator->()
+    {
+        if ( ! has_value() )
+            report_bad_status_value_access( m_status );
+
+        return contained.value_ptr();
+    }
+
+    value_type const & operator *() const &
+    {
+        return value();
+    }
+
+    value_type & operator *() &
+    {
+        return value();
+    }
+
+    value_type const && operator*() const &&
+    {
+        return std::move( value() );
+    }
+
+    value_type && operator*() &&
+    {
+        return std::move( value() );
+    }
+
+private:
+    template< typename S2, typename V2 >
+    friend class status_value;
+
+    // the status constructed in place from s, using alloc if it uses one, without a value:
+
+    template< typename Alloc, typename SArg >
+    status_value( status_value_detail::uses_allocator_kind<0>, Alloc const &, SArg && s )
+    : m_status( std::forward<SArg>( s ) )
+    , m_has_value( false )
+    {}
+
+    template< typename Alloc, typename SArg >
+    status_value( status_value_detail::uses_allocator_kind<1>, Alloc const & alloc, SArg && s )
+    : m_status( std::allocator_arg, alloc, std::forward<SArg>( s ) )
+    , m_has_value( false )
+    {}
+
+    template< typename Alloc, typename SArg >
+    status_value( status_value_detail::uses_allocator_kind<2>, Alloc const & alloc, SArg && s )
+    : m_status( std::forward<SArg>( s ), alloc )
+    , m_has_value( false )
+    {}
+
+    template< typename S2, typename V2 >
+    void move_converted_value_from( status_value<S2, V2> & other )
+    {
+        if ( other.m_has_value )
+        {
+            contained.emplace_value( std::move( other.contained ).value() );
+            other.contained.destruct_value();
+            other.m_has_value = false;
+        }
+    }
+
+    friend struct status_value_detail::unchecked_access;
+
+    using storage_type = typename status_value_detail::storage_of<S, V>::type;
+
+    storage_type contained;
+    status_type m_status;
+    bool m_has_value;
+};
+
+// Create a status_value with the value constructed in place from the result of f( args... ):
+
+template< typename S, typename F, typename... Args
+    , typename V = typename std::decay< status_value_detail::invoke_result_t<F, Args...> >::type
+>
+status_value<S, V> make_status_value_with( S s, F && f, Args&&... args )
+{
+    return status_value<S, V>( std::move( s ), from_invoke, std::forward<F>( f ), std::forward<Args>( args )... );
+}
+
+// Status and optional reference:
+//
+// Holds a pointer to the referred object and never copies it. Access is checked
+// like that of status_value<S, V>, assignment rebinds the reference, and the
+// type is trivially copyable if S is.
+
+template< typename S, typename V >
+class status_value< S, V & >
+{
+public:
+    typedef S status_type;
+    typedef V value_type;
+
+    // constructors
+
+    status_value() = delete;
+
+    status_value( status_type s )
+    : m_status( std::move( s ) )
+    , m_ptr( nullptr )
+    {}
+
+    status_value( status_type s, value_type & v ) nsstsv_noexcept
+    : m_status( std::move( s ) )
+    , m_ptr( &v )
+    {}
+
+    // disallow binding to a temporary:
+
+    status_value( status_type s, value_type && v ) = delete;
+
+    // from a reference to a derived or less cv-qualified type:
+
+    template< typename U
+        , typename = typename std::enable_if< std::is_convertible<U *, V *>::value && ! std::is_same<U, V>::value >::type
+    >
+    status_value( status_value<S, U &> const & other )
+    : m_status( other.status() )
+    , m_ptr( other.has_value() ? &*other : nullptr )
+    {}
+
+    status_value( status_value const & other ) = default;
+
+    // assignment rebinds the reference
+
+    status_value & operator=( status_value const & other ) = default;
+
+    // status observers
+
+    status_type const & status() const & nsstsv_noexcept
+    {
+        return m_status;
+    }
+
+    status_type && status() && nsstsv_noexcept
+    {
+        return std::move( m_status );
+    }
+
+    // state observers
+
+    constexpr bool has_value() const nsstsv_noexcept
+    {
+        return m_ptr != nullptr;
+    }
+
+    constexpr explicit operator bool() const nsstsv_noexcept
+    {
+        return has_value();
+    }
+
+    // value observers, const does not propagate to the referred object;
+    // throw bad_status_value_access<S> regardless of the constness of this
+
+    value_type & value() const
+    {
+        if ( ! has_value() )
+            report_bad_status_value_access( status_type( m_status ) );
+
+        return *m_ptr;
+    }
+
+    value_type * operator->() const
+    {
+        return &value();
+    }
+
+    value_type & operator*() const
+    {
+        return value();
+    }
+
+private:
+    friend struct status_value_detail::unchecked_access;
+
+    status_type m_status;
+    value_type * m_ptr;
+};
+
+// Success predicate of a status: specialize status_success_traits<S> with
+// static bool is_success( S const & ) to let status_value<S, void> derive its
+// engagement from the status. No status has one unless it opts in:
+
+template< typename S, typename = void >
+struct status_success_traits {};
+
+// Derive a specialization from this to use member bool ok() const of S:
+
+template< typename S >
+struct member_ok_success
+{
+    static constexpr bool is_success( S const & s ) noexcept( noexcept( s.ok() ) )
+    {
+        return s.ok();
+    }
+};
+
+// Tag to construct an engaged status_value<S, void>:
+
+struct engaged_t
+{
+    explicit engaged_t() = default;
+};
+
+constexpr engaged_t engaged{};
+
+namespace status_value_detail {
+
+template< typename S, typename = void >
+struct has_success_predicate : std::false_type {};
+
+template< typename S >
+struct has_success_predicate< S, decltype( void( status_success_traits<S>::is_success( std::declval<S const &>() ) ) ) > : std::true_type {};
+
+// Status and engagement of status_value<S, void>, or status only with a success predicate:
+
+template< typename S, bool = has_success_predicate<S>::value >
+struct void_state
+{
+    S m_status;
+    bool m_has_value;
+
+    nsstsv_constexpr14 void_state( S && s, bool engaged )
+    : m_status( std::move( s ) )
+    , m_has_value( engaged )
+    {}
+
+    template< typename Alloc, typename SArg >
+    void_state( std::allocator_arg_t, Alloc const & alloc, SArg && s, bool engaged )
+    : void_state( uses_allocator_construction<S, Alloc, SArg>(), alloc, std::forward<SArg>( s ), engaged )
+    {}
+
+    // the status constructed in place from s, using alloc if it uses one:
+
+    template< typename Alloc, typename SArg >
+    void_state( uses_allocator_kind<0>, Alloc const &, SArg && s, bool engaged )
+    : m_status( std::forward<SArg>( s ) )
+    , m_has_value( engaged )
+    {}
+
+    template< typename Alloc, typename SArg >
+    void_state( uses_allocator_kind<1>, Alloc const & alloc, SArg && s, bool engaged )
+    : m_status( std::allocator_arg, alloc, std::forward<SArg>( s ) )
+    , m_has_value( engaged )
+    {}
+
+    template< typename Alloc, typename SArg >
+    void_state( uses_allocator_kind<2>, Alloc const & alloc, SArg && s, bool engaged )
+    : m_status( std::forward<SArg>( s ), alloc )
+    , m_has_value( engaged )
+    {}
+
+    constexpr bool has_value() const nsstsv_noexcept
+    {
+        return m_has_value;
+    }
+};
+
+template< typename S >
+struct void_state< S, true >
+{
+    S m_status;
+
+    nsstsv_constexpr14 void_state( S && s, bool /*engaged*/ )
+    : m_status( std::move( s ) )
+    {}
+
+    template< typename Alloc, typename SArg >
+    void_state( std::allocator_arg_t, Alloc const & alloc, SArg && s, bool /*engaged*/ )
+    : void_state( uses_allocator_construction<S, Alloc, SArg>(), alloc, std::forward<SArg>( s ) )
+    {}
+
+    // the status constructed in place from s, using alloc if it uses one:
+
+    template< typename Alloc, typename SArg >
+    void_state( uses_allocator_kind<0>, Alloc const &, SArg && s )
+    : m_status( std::forward<SArg>( s ) )
+    {}
+
+    template< typename Alloc, typename SArg >
+    void_state( uses_allocator_kind<1>, Alloc const & alloc, SArg && s )
+    : m_status( std::allocator_arg, alloc, std::forward<SArg>( s ) )
+    {}
+
+    template< typename Alloc, typename SArg >
+    void_state( uses_allocator_kind<2>, Alloc const & alloc, SArg && s )
+    : m_status( std::forward<SArg>( s ), alloc )
+    {}
+
+    constexpr bool has_value() const noexcept( noexcept( status_success_traits<S>::is_success( std::declval<S const &>() ) ) )
+    {
+        return status_success_traits<S>::is_success( m_status );
+    }
+};
+
+} // namespace status_value_detail
+
+// Status-only result:
+//
+// Holds the status and whether the operation succeeded, or only the status if
+// status_success_traits<S> provides a success predicate. The type is copyable,
+// and trivially copyable if S is.
+
+template< typename S >
+class status_value< S, void >
+{
+public:
+    typedef S status_type;
+    typedef void value_type;
+
+    // constructors
+
+    status_value() = delete;
+
+    // failure, or engagement according to the success predicate:
+
+    nsstsv_constexpr14 status_value( status_type s )
+    : m_state( std::move( s ), false )
+    {}
+
+    // success, without success predicate:
+
+    template< typename T = S
+        , typename = typename std::enable_if< ! status_value_detail::has_success_predicate<T>::value >::type
+    >
+    nsstsv_constexpr14 status_value( status_type s, engaged_t )
+    : m_state( std::move( s ), true )
+    {}
+
+    template< typename Alloc, typename SArg
+        , typename std::enable_if<
+            status_value_detail::is_constructible_using_allocator< S, Alloc, SArg >::value
+            && ! std::is_same< typename std::decay<SArg>::type, status_value >::value, int >::type = 0
+    >
+    status_value( std::allocator_arg_t, Alloc const & alloc, SArg && s )
+    : m_state( std::allocator_arg, alloc, std::forward<SArg>( s ), false )
+    {}
+
+    template< typename Alloc, typename SArg, typename T = S
+        , typename std::enable_if<
+            status_value_detail::is_constructible_using_allocator< S, Alloc, SArg >::value
+            && ! status_value_detail::has_success_predicate<T>::value, int >::type = 0
+    >
+    status_value( std::allocator_arg_t, Alloc const & alloc, SArg && s, engaged_t )
+    : m_state( std::allocator_arg, alloc, std::forward<SArg>( s ), true )
+    {}
+
+    // status observers
+
+    status_type const & status() const & nsstsv_noexcept
+    {
+        return m_state.m_status;
+    }
+
+    status_type && status() && nsstsv_noexcept
+    {
+        return std::move( m_state.m_status );
+    }
+
+    // state observers
+
+    constexpr bool has_value() const noexcept( noexcept( std::declval< status_value_detail::void_state<S> const & >().has_value() ) )
+    {
+        return m_state.has_value();
+    }
+
+    constexpr explicit operator bool() const noexcept( noexcept( std::declval< status_value_detail::void_state<S> const & >().has_value() ) )
+    {
+        return has_value();
+    }
+
+    // value observer: checks for success
+
+    void value() const
+    {
+        if ( ! has_value() )
+            report_bad_status_value_access( status_type( m_state.m_status ) );
+    }
+
+private:
+    status_value_detail::void_state<S> m_state;
+};
+
+// Sharing modes of boxed_status<>:
+
+struct box_unique {};           // sole owner, copy duplicates the details
+struct box_refcount {};         // shared details, non-atomic reference count
+struct box_atomic_refcount {};  // shared details, atomic reference count
+
+namespace status_value_detail {
+
+template< typename Mode >
+struct box_count;
+
+template<>
+struct box_count< box_unique >
+{
+    void init() nsstsv_noexcept {}
+    void acquire() nsstsv_noexcept {}
+    bool release() nsstsv_noexcept { return true; }
+    std::size_t count() const nsstsv_noexcept { return 1; }
+};
+
+template<>
+struct box_count< box_refcount >
+{
+    void init() nsstsv_noexcept { n = 1; }
+    void acquire() nsstsv_noexcept { ++n; }
+    bool release() nsstsv_noexcept { return --n == 0; }
+    std::size_t count() const nsstsv_noexcept { return n; }
+
+    std::size_t n;
+};
+
+template<>
+struct box_count< box_atomic_refcount >
+{
+    void init() nsstsv_noexcept { n.store( 1, std::memory_order_relaxed ); }
+    void acquire() nsstsv_noexcept { n.fetch_add( 1, std::memory_order_relaxed ); }
+    bool release() nsstsv_noexcept { return n.fetch_sub( 1, std::memory_order_acq_rel ) == 1; }
+    std::size_t count() const nsstsv_noexcept { return n.load( std::memory_order_relaxed ); }
+
+    std::atomic<std::size_t> n;
+};
+
+template< typename T, typename Mode >
+struct box_node
+{
+    template< typename... Args >
+    box_node( Args&&... args )
+    : value( std::forward<Args>( args )... )
+    {
+        refs.init();
+    }
+
+    T value;
+    box_count<Mode> refs;
+};
+
+} // namespace status_value_detail
+
+// Status with out-of-line details:
+//
+// A null pointer represents success; details are allocated from Pool only
+// to report a failure, so the success path carries a single pointer.
+
+template< typename T, typename Mode = box_unique, template< typename > class Pool = heap_box_pool >
+class boxed_status
+{
+public:
+    typedef T details_type;
+    typedef Mode mode_type;
+
+    // block type allocated from Pool:
+
+    typedef status_value_detail::box_node<T, Mode> node_type;
+
+    // constructors
+
+    boxed_status() nsstsv_noexcept
+    : m_node( nullptr )
+    {}
+
+    boxed_status( details_type const & details )
+    : m_node( create( details ) )
+    {}
+
+    boxed_status( details_type && details )
+    : m_node( create( std::move( details ) ) )
+    {}
+
+    boxed_status( boxed_status const & other )
+    : m_node( copy( other.m_node, std::is_same<Mode, box_unique>() ) )
+    {}
+
+    boxed_status( boxed_status && other ) nsstsv_noexcept
+    : m_node( other.m_node )
+    {
+        other.m_node = nullptr;
+    }
+
+    template< typename... Args >
+    static boxed_status make( Args&&... args )
+    {
+        return boxed_status( create( std::forward<Args>( args )... ) );
+    }
+
+    // destructor
+
+    ~boxed_status()
+    {
+        reset();
+    }
+
+    // assignment
+
+    boxed_status & operator=( boxed_status other ) nsstsv_noexcept
+    {
+        swap( other );
+        return *this;
+    }
+
+    void reset() nsstsv_noexcept
+    {
+        if ( m_node != nullptr && m_node->refs.release() )
+        {
+            m_node->~node_type();
+            Pool<node_type>::deallocate( m_node );
+        }
+        m_node = nullptr;
+    }
+
+    void swap( boxed_status & other ) nsstsv_noexcept
+    {
+        std::swap( m_node, other.m_node );
+    }
+
+    // observers
+
+    bool ok() const nsstsv_noexcept
+    {
+        return m_node == nullptr;
+    }
+
+    details_type const * get() const nsstsv_noexcept
+    {
+        return m_node != nullptr ? &m_node->value : nullptr;
+    }
+
+    // precondition: ! ok()
+
+    details_type const & operator*() const nsstsv_noexcept
+    {
+        return m_node->value;
+    }
+
+    details_type const * operator->() const nsstsv_noexcept
+    {
+        return &m_node->value;
+    }
+
+    std::size_t use_count() const nsstsv_noexcept
+    {
+        return m_node != nullptr ? m_node->refs.count() : 0;
+    }
+
+    friend bool operator==( boxed_status const & a, boxed_status const & b )
+    {
+        return a.m_node == b.m_node
+            || ( a.m_node != nullptr && b.m_node != nullptr && a.m_node->value == b.m_node->value );
+    }
+
+    friend bool operator!=( boxed_status const & a, boxed_status const & b )
+    {
+        return !( a == b );
+    }
+
+private:
+    explicit boxed_status( node_type * n ) nsstsv_noexcept
+    : m_node( n )
+    {}
+
+    template< typename... Args >
+    static node_type * create( Args&&... args )
+    {
+        status_value_detail::box_block_guard<Pool, node_type> guard = { Pool<node_type>::allocate() };
+
+        node_type * n = ::new( guard.block ) node_type( std::forward<Args>( args )... );
+        guard.block = nullptr;
+        return n;
+    }
+
+    static node_type * copy( node_type * n, std::true_type /*unique*/ )
+    {
+        return n != nullptr ? create( n->value ) : nullptr;
+    }
+
+    static node_type * copy( node_type * n, std::false_type /*shared*/ ) nsstsv_noexcept
+    {
+        if ( n != nullptr )
+            n->refs.acquire();
+        return n;
+    }
+
+    node_type * m_node;
+};
+
+template< typename T, typename Mode = box_unique, template< typename > class Pool = heap_box_pool, typename... Args >
+boxed_status<T, Mode, Pool> make_boxed_status( Args&&... args )
+{
+    return boxed_status<T, Mode, Pool>::make( std::forward<Args>( args )... );
+}
+
+namespace status_value_detail {
+
+// Manual vtable for the payload of payload_status:
+
+struct payload_vtable
+{
+    void ( * copy    )( void const * src, void * dst );
+    void ( * move    )( void * src, void * dst ) nsstsv_noexcept;
+    void ( * destroy )( void * buf ) nsstsv_noexcept;
+    void const * ( * get )( void const * buf ) nsstsv_noexcept;
+    bool on_heap;
+};
+
+inline std::atomic<std::size_t> & payload_heap_allocations() nsstsv_noexcept
+{
+    static std::atomic<std::size_t> count( 0 );
+    return count;
+}
+
+inline std::atomic<std::size_t> & payload_heap_deallocations() nsstsv_noexcept
+{
+    static std::atomic<std::size_t> count( 0 );
+    return count;
+}
+
+template< typename P, bool OnHeap >
+struct payload_ops;
+
+// Payload constructed in the buffer:
+
+template< typename P >
+struct payload_ops< P, false >
+{
+    template< typename U >
+    static void construct( void * buf, U && payload )
+    {
+        ::new( buf ) P( std::forward<U>( payload ) );
+    }
+
+    static void copy( void const * src, void * dst )
+    {
+        ::new( dst ) P( *static_cast<P const *>( src ) );
+    }
+
+    static void move( void * src, void * dst ) nsstsv_noexcept
+    {
+        ::new( dst ) P( std::move( *static_cast<P *>( src ) ) );
+        destroy( src );
+    }
+
+    static void destroy( void * buf ) nsstsv_noexcept
+    {
+        static_cast<P *>( buf )->~P();
+    }
+
+    static void const * get( void const * buf ) nsstsv_noexcept
+    {
+        return buf;
+    }
+
+    static payload_vtable const * vtable() nsstsv_noexcept
+    {
+        static payload_vtable const table = { &copy, &move, &destroy, &get, false };
+        return &table;
+    }
+};
+
+// Buffer holds pointer to payload:
+
+template< typename P >
+struct payload_ops< P, true >
+{
+    template< typename U >
+    static void construct( void * buf, U && payload )
+    {
+        ::new( buf ) P*( new P( std::forward<U>( payload ) ) );
+        ++payload_heap_allocations();
+    }
+
+    static void copy( void const * src, void * dst )
+    {
+        construct( dst, *ptr( src ) );
+    }
+
+    static void move( void * src, void * dst ) nsstsv_noexcept
+    {
+        ::new( dst ) P*( ptr( src ) );
+    }
+
+    static void destroy( void * buf ) nsstsv_noexcept
+    {
+        delete ptr( buf );
+        ++payload_heap_deallocations();
+    }
+
+    static void const * get( void const * buf ) nsstsv_noexcept
+    {
+        return ptr( buf );
+    }
+
+    static payload_vtable const * vtable() nsstsv_noexcept
+    {
+        static payload_vtable const table = { &copy, &move, &destroy, &get, true };
+        return &table;
+    }
+
+private:
+    static P * ptr( void const * buf ) nsstsv_noexcept
+    {
+        return *static_cast<P * const *>( buf );
+    }
+};
+
+} // namespace status_value_detail
+
+// Status code with a type-erased payload:
+//
+// Payloads that fit the inline buffer of N bytes and are nothrow move
+// constructible are stored inline, others on the heap.
+
+template< typename Code = int, std::size_t N = nsstsv_CONFIG_PAYLOAD_INLINE_SIZE >
+class basic_payload_status
+{
+    typedef status_value_detail::payload_vtable vtable_type;
+    enum : std::size_t { buffer_size = N < sizeof(void*) ? sizeof(void*) : N };
+
+public:
+    typedef Code code_type;
+
+    template< typename P >
+    struct fits_inline : std::integral_constant< bool,
+        sizeof(P) <= buffer_size && alignof(double) % alignof(P) == 0
+            && std::is_nothrow_move_constructible<P>::value > {};
+
+private:
+    template< typename P >
+    struct ops : status_value_detail::payload_ops< P, ! fits_inline<P>::value > {};
+
+public:
+    // constructors
+
+    basic_payload_status()
+    : m_vtable( nullptr )
+    , m_code()
+    {}
+
+    basic_payload_status( code_type code )
+    : m_vtable( nullptr )
+    , m_code( std::move( code ) )
+    {}
+
+    template< typename P >
+    basic_payload_status( code_type code, P && payload )
+    : m_vtable( nullptr )
+    , m_code( std::move( code ) )
+    {
+        typedef typename std::decay<P>::type payload_type;
+
+        ops<payload_type>::construct( &m_buffer, std::forward<P>( payload ) );
+        m_vtable = ops<payload_type>::vtable();
+    }
+
+    basic_payload_status( basic_payload_status const & other )
+    : m_vtable( nullptr )
+    , m_code( other.m_code )
+    {
+        if ( other.m_vtable != nullptr )
+        {
+            other.m_vtable->copy( &other.m_buffer, &m_buffer );
+            m_vtable = other.m_vtable;
+        }
+    }
+
+    basic_payload_status( basic_payload_status && other ) nsstsv_noexcept
+    : m_vtable( nullptr )
+    , m_code( std::move( other.m_code ) )
+    {
+        adopt( other );
+    }
+
+    // destructor
+
+    ~basic_payload_status()
+    {
+        reset_payload();
+    }
+
+    // assignment
+
+    basic_payload_status & operator=( basic_payload_status other ) nsstsv_noexcept
+    {
+        reset_payload();
+        m_code = std::move( other.m_code );
+        adopt( other );
+        return *this;
+    }
+
+    void reset_payload() nsstsv_noexcept
+    {
+        if ( m_vtable != nullptr )
+        {
+            m_vtable->destroy( &m_buffer );
+            m_vtable = nullptr;
+        }
+    }
+
+    // observers
+
+    code_type const & code() const nsstsv_noexcept
+    {
+        return m_code;
+    }
+
+    bool has_payload() const nsstsv_noexcept
+    {
+        return m_vtable != nullptr;
+    }
+
+    bool payload_is_inline() const nsstsv_noexcept
+    {
+        return m_vtable != nullptr && ! m_vtable->on_heap;
+    }
+
+    template< typename P >
+    bool holds() const nsstsv_noexcept
+    {
+        return m_vtable != nullptr && m_vtable == ops<P>::vtable();
+    }
+
+    template< typename P >
+    P const * payload() const nsstsv_noexcept
+    {
+        return holds<P>() ? static_cast<P const *>( m_vtable->get( &m_buffer ) ) : nullptr;
+    }
+
+    // heap allocation counters of all payload_status types:
+
+    static std::size_t heap_allocations() nsstsv_noexcept
+    {
+        return status_value_detail::payload_heap_allocations().load( std::memory_order_relaxed );
+    }
+
+    static std::size_t heap_deallocations() nsstsv_noexcept
+    {
+        return status_value_detail::payload_heap_deallocations().load( std::memory_order_relaxed );
+    }
+
+private:
+    void adopt( basic_payload_status & other ) nsstsv_noexcept
+    {
+        if ( other.m_vtable != nullptr )
+        {
+            other.m_vtable->move( &other.m_buffer, &m_buffer );
+            m_vtable = other.m_vtable;
+            other.m_vtable = nullptr;
+        }
+    }
+
+    vtable_type const * m_vtable;
+    code_type m_code;
+    alignas( double ) unsigned char m_buffer[ buffer_size ];
+};
+
+typedef basic_payload_status<> payload_status;
+
+#if nsstsv_HAVE_STRING_VIEW
+
+// Entry of a status_message_table:
+
+template< typename E >
+struct status_message_entry
+{
+    E code;
+    std::string_view message;
+};
+
+namespace status_value_detail {
+
+// Order-preserving mapping of an integral or enumeration code to an unsigned key:
+
+template< typename E >
+constexpr std::uint64_t message_key( E code ) noexcept
+{
+    using underlying = typename std::conditional< std::is_enum<E>::value, std::underlying_type<E>, std::common_type<E> >::type::type;
+
+    if constexpr ( std::is_signed<underlying>::value )
+        return static_cast<std::uint64_t>( static_cast<std::int64_t>( code ) ) ^ ( std::uint64_t( 1 ) << 63 );
+    else
+        return static_cast<std::uint64_t>( code );
+}
+
+// FNV-1a:
+
+constexpr std::uint64_t message_hash( std::string_view text ) noexcept
+{
+    std::uint64_t h = 14695981039346656037ull;
+
+    for ( char c : text )
+    {
+        h = ( h ^ static_cast<unsigned char>( c ) ) * 1099511628211ull;
+    }
+    return h;
+}
+
+// Finalizer of splitmix64, to derive the bucket and slots of a code:
+
+constexpr std::uint64_t message_mix( std::uint64_t z ) noexcept
+{
+    z = ( z ^ ( z >> 30 ) ) * 0xBF58476D1CE4E5B9ull;
+    z = ( z ^ ( z >> 27 ) ) * 0x94D049BB133111EBull;
+    return z ^ ( z >> 31 );
+}
+
+// Not constexpr, so that building a table at compile time fails on these,
+// naming the code type in the diagnostic; at run time they throw, or abort
+// without exceptions:
+
+template< typename E >
+nsstsv_noreturn void status_message_table_duplicate_code()
+{
+#if nsstsv_CONFIG_NO_EXCEPTIONS
+    std::abort();
+#else
+    throw std::logic_error( "status_message_table: duplicate code" );
+#endif
+}
+
+template< typename E >
+nsstsv_noreturn void status_message_table_no_perfect_hash()
+{
+#if nsstsv_CONFIG_NO_EXCEPTIONS
+    std::abort();
+#else
+    throw std::logic_error( "status_message_table: no perfect hash for the codes" );
+#endif
+}
+
+// Power of two of at least twice the number of entries:
+
+constexpr unsigned message_slot_bits( std::size_t n ) noexcept
+{
+    unsigned bits = 1;
+
+    while ( ( std::size_t( 1 ) << bits ) < 2 * n )
+        ++bits;
+
+    return bits;
+}
+
+} // namespace status_value_detail
+
+// Compile-time table to map status codes to messages and back:
+//
+// Codes are looked up directly when their range fits the table, otherwise
+// via a perfect hash: codes are hashed to buckets and each bucket gets the
+// first seed that places its codes in free slots, largest buckets first.
+// Either way a code is found in a single probe. Codes must be unique; a table
+// built at compile time fails to compile if they are not, one built at run
+// time throws std::logic_error. Messages are found via a hash with linear
+// probing.
+
+template< typename E, std::size_t N >
+class status_message_table
+{
+public:
+    typedef E code_type;
+    typedef status_message_entry<E> entry_type;
+
+    static constexpr unsigned    slot_bits  = status_value_detail::message_slot_bits( N );
+    static constexpr std::size_t slot_count = std::size_t( 1 ) << slot_bits;
+
+    constexpr explicit status_message_table( entry_type const ( & entries )[N] )
+    {
+        std::uint64_t lo = status_value_detail::message_key( entries[0].code );
+        std::uint64_t hi = lo;
+
+        for ( std::size_t i = 0; i < N; ++i )
+        {
+            std::uint64_t const k = status_value_detail::message_key( entries[i].code );
+
+            lo = k < lo ? k : lo;
+            hi = k > hi ? k : hi;
+            m_entries[i] = entries[i];
+        }
+
+        m_offset = lo;
+        m_dense  = hi - lo < slot_count;
+
+        if ( m_dense )
+        {
+            for ( std::size_t i = 0; i < N; ++i )
+            {
+                std::size_t const s = code_slot( m_entries[i].code );
+
+                if ( m_code_slots[s] != 0 )
+                    status_value_detail::status_message_table_duplicate_code<E>();
+
+                m_code_slots[s] = i + 1;
+            }
+        }
+        else
+        {
+            place_codes();
+        }
+
+        for ( std::size_t i = 0; i < N; ++i )
+        {
+            insert( m_message_slots, message_slot( m_entries[i].message ), i );
+        }
+    }
+
+    constexpr std::size_t size() const noexcept
+    {
+        return N;
+    }
+
+    constexpr bool is_dense() const noexcept
+    {
+        return m_dense;
+    }
+
+    constexpr entry_type const * begin() const noexcept
+    {
+        return m_entries;
+    }
+
+    constexpr entry_type const * end() const noexcept
+    {
+        return m_entries + N;
+    }
+
+    // message for code, empty if code is unknown:
+
+    constexpr std::string_view message( code_type code ) const noexcept
+    {
+        entry_type const * e = find( code );
+        return e != nullptr ? e->message : std::string_view();
+    }
+
+    constexpr bool contains( code_type code ) const noexcept
+    {
+        return find( code ) != nullptr;
+    }
+
+    constexpr entry_type const * find( code_type code ) const noexcept
+    {
+        std::size_t const i = m_code_slots[ code_slot( code ) ];
+
+        return i != 0 && m_entries[i - 1].code == code ? &m_entries[i - 1] : nullptr;
+    }
+
+    // entry for message (reverse lookup), nullptr if message is unknown:
+
+    constexpr entry_type const * find( std::string_view message ) const noexcept
+    {
+        for ( std::size_t s = message_slot( message ); m_message_slots[s] != 0; s = ( s + 1 ) & ( slot_count - 1 ) )
+        {
+            entry_type const & e = m_entries[ m_message_slots[s] - 1 ];
+
+            if ( e.message == message )
+                return &e;
+        }
+        return nullptr;
+    }
+
+private:
+    // seeds tried per bucket before giving up on a perfect hash:
+
+    static constexpr std::uint32_t max_seeds = 4096;
+
+    constexpr std::size_t code_bucket( code_type code ) const noexcept
+    {
+        return static_cast<std::size_t>( status_value_detail::message_mix( status_value_detail::message_key( code ) ) >> ( 64 - slot_bits ) );
+    }
+
+    constexpr std::size_t code_slot( code_type code ) const noexcept
+    {
+        std::uint64_t const k = status_value_detail::message_key( code );
+
+        return m_dense
+            ? static_cast<std::size_t>( ( k - m_offset ) & ( slot_count - 1 ) )
+            : static_cast<std::size_t>( status_value_detail::message_mix( k + ( m_seeds[ code_bucket( code ) ] + 1ull ) * 0x9E3779B97F4A7C15ull ) & ( slot_count - 1 ) );
+    }
+
+    constexpr std::size_t message_slot( std::string_view message ) const noexcept
+    {
+        return static_cast<std::size_t>( status_value_detail::message_hash( message ) & ( slot_count - 1 ) );
+    }
+
+    // place the largest buckets first, while most slots are free:
+
+    constexpr void place_codes()
+    {
+        std::size_t sizes[ slot_count ] = {};
+        std::size_t largest = 0;
+
+        for ( std::size_t i = 0; i < N; ++i )
+        {
+            std::size_t const n = ++sizes[ code_bucket( m_entries[i].code ) ];
+
+            largest = n > largest ? n : largest;
+        }
+
+        for ( std::size_t n = largest; n > 0; --n )
+        {
+            for ( std::size_t b = 0; b < slot_count; ++b )
+            {
+                if ( sizes[b] == n )
+                    place_bucket( b );
+            }
+        }
+    }
+
+    constexpr void place_bucket( std::size_t b )
+    {
+        for ( std::uint32_t seed = 0; seed < max_seeds; ++seed )
+        {
+            m_seeds[b] = seed;
+
+            if ( try_place( b ) )
+                return;
+        }
+        status_value_detail::status_message_table_no_perfect_hash<E>();
+    }
+
+    // place the codes of bucket b in free slots with its current seed, or none of them:
+
+    constexpr bool try_place( std::size_t b )
+    {
+        std::size_t placed[N] = {};
+        std::size_t count = 0;
+
+        for ( std::size_t i = 0; i < N; ++i )
+        {
+            if ( code_bucket( m_entries[i].code ) != b )
+                continue;
+
+            std::size_t const s = code_slot( m_entries[i].code );
+
+            if ( m_code_slots[s] != 0 )
+            {
+                if ( m_entries[ m_code_slots[s] - 1 ].code == m_entries[i].code )
+                    status_value_detail::status_message_table_duplicate_code<E>();
+
+                while ( count > 0 )
+                    m_code_slots[ placed[--count] ] = 0;
+
+                return false;
+            }
+
+            m_code_slots[s] = i + 1;
+            placed[count++] = s;
+        }
+        return true;
+    }
+
+    static constexpr void insert( std::size_t ( & slots )[ slot_count ], std::size_t s, std::size_t i ) noexcept
+    {
+        while ( slots[s] != 0 )
+            s = ( s + 1 ) & ( slot_count - 1 );
+
+        slots[s] = i + 1;
+    }
+
+    entry_type m_entries[N] = {};
+    std::size_t m_code_slots[ slot_count ] = {};
+    std::size_t m_message_slots[ slot_count ] = {};
+    std::uint32_t m_seeds[ slot_count ] = {};
+    std::uint64_t m_offset = 0;
+    bool m_dense = true;
+};
+
+template< typename E, std::size_t N >
+constexpr status_message_table<E, N> make_status_message_table( status_message_entry<E> const ( & entries )[N] )
+{
+    return status_message_table<E, N>( entries );
+}
+
+#endif // nsstsv_HAVE_STRING_VIEW
+
+// Failures collected in inline storage for N statuses, beyond which they spill to the heap:
+
+template< typename S, std::size_t N >
+class accumulated_status
+{
+    static_assert( N > 0, "accumulated_status: inline capacity must be at least one" );
+    static_assert( std::is_nothrow_move_constructible<S>::value, "accumulated_status: status shall be nothrow move constructible" );
+
+public:
+    typedef S value_type;
+    typedef std::size_t size_type;
+    typedef S const * const_iterator;
+
+    static constexpr size_type inline_capacity = N;
+
+    // constructors
+
+    accumulated_status() nsstsv_noexcept
+    : m_data( inline_data() )
+    , m_size( 0 )
+    , m_capacity( N )
+    {}
+
+    accumulated_status( value_type failure )
+    : accumulated_status()
+    {
+        push_back( std::move( failure ) );
+    }
+
+    accumulated_status( accumulated_status const & other )
+    : accumulated_status()
+    {
+        reserve( other.m_size );
+
+        for ( value_type const & failure : other )
+        {
+            push_back( failure );
+        }
+    }
+
+    accumulated_status( accumulated_status && other ) nsstsv_noexcept
+    : accumulated_status()
+    {
+        adopt( other );
+    }
+
+    // destructor
+
+    ~accumulated_status()
+    {
+        release();
+    }
+
+    // assignment
+
+    accumulated_status & operator=( accumulated_status other ) nsstsv_noexcept
+    {
+        release();
+        m_data = inline_data();
+        m_capacity = N;
+        adopt( other );
+        return *this;
+    }
+
+    // modifiers
+
+    void push_back( value_type const & failure )
+    {
+        emplace_back( failure );
+    }
+
+    void push_back( value_type && failure )
+    {
+        emplace_back( std::move( failure ) );
+    }
+
+    template< typename... Args >
+    value_type & emplace_back( Args&&... args )
+    {
+        if ( m_size == m_capacity )
+            return grow_and_emplace_back( std::forward<Args>( args )... );
+
+        value_type * failure = ::new( m_data + m_size ) value_type( std::forward<Args>( args )... );
+        ++m_size;
+        return *failure;
+    }
+
+    void reserve( size_type capacity )
+    {
+        if ( capacity <= m_capacity )
+            return;
+
+        value_type * data = allocate( capacity );
+
+        relocate( m_data, m_size, data );
+        deallocate_spilled();
+
+        m_data = data;
+        m_capacity = capacity;
+    }
+
+    void clear() nsstsv_noexcept
+    {
+        destroy( m_data, m_size );
+        m_size = 0;
+    }
+
+    // observers
+
+    bool ok() const nsstsv_noexcept
+    {
+        return m_size == 0;
+    }
+
+    bool empty() const nsstsv_noexcept
+    {
+        return m_size == 0;
+    }
+
+    size_type size() const nsstsv_noexcept
+    {
+        return m_size;
+    }
+
+    size_type capacity() const nsstsv_noexcept
+    {
+        return m_capacity;
+    }
+
+    bool is_inline() const nsstsv_noexcept
+    {
+        return m_data == inline_data();
+    }
+
+    value_type const & operator[]( size_type pos ) const nsstsv_noexcept
+    {
+        return m_data[pos];
+    }
+
+    value_type const & front() const nsstsv_noexcept
+    {
+        return m_data[0];
+    }
+
+    value_type const & back() const nsstsv_noexcept
+    {
+        return m_data[m_size - 1];
+    }
+
+    const_iterator begin() const nsstsv_noexcept
+    {
+        return m_data;
+    }
+
+    const_iterator end() const nsstsv_noexcept
+    {
+        return m_data + m_size;
+    }
+
+    friend bool operator==( accumulated_status const & a, accumulated_status const & b )
+    {
+        if ( a.size() != b.size() )
+            return false;
+
+        for ( size_type i = 0; i < a.size(); ++i )
+        {
+            if ( !( a[i] == b[i] ) )
+                return false;
+        }
+        return true;
+    }
+
+    friend bool operator!=( accumulated_status const & a, accumulated_status const & b )
+    {
+        return !( a == b );
+    }
+
+private:
+    // spilled storage, also for an over-aligned status, released unless taken:
+
+    struct spill_guard
+    {
+        value_type * data;
+
+        ~spill_guard()
+        {
+            if ( data )
+                deallocate( data );
+        }
+    };
+
+    static value_type * allocate( size_type capacity )
+    {
+        return static_cast<value_type *>( status_value_detail::allocate_block<value_type>( capacity ) );
+    }
+
+    static void deallocate( value_type * data ) nsstsv_noexcept
+    {
+        status_value_detail::deallocate_block<value_type>( data );
+    }
+
+    void deallocate_spilled() nsstsv_noexcept
+    {
+        if ( ! is_inline() )
+            deallocate( m_data );
+    }
+
+    value_type * inline_data() nsstsv_noexcept
+    {
+        return reinterpret_cast<value_type *>( &m_inline );
+    }
+
+    value_type const * inline_data() const nsstsv_noexcept
+    {
+        return reinterpret_cast<value_type const *>( &m_inline );
+    }
+
+    // construct new failure before relocating, as args may refer to a current one:
+
+    template< typename... Args >
+    value_type & grow_and_emplace_back( Args&&... args )
+    {
+        size_type const capacity = 2 * m_capacity;
+        value_type * data = allocate( capacity );
+
+        spill_guard guard = { data };
+
+        ::new( data + m_size ) value_type( std::forward<Args>( args )... );
+        guard.data = nullptr;
+
+        relocate( m_data, m_size, data );
+        deallocate_spilled();
+
+        m_data = data;
+        m_capacity = capacity;
+        return m_data[ m_size++ ];
+    }
+
+    static void relocate( value_type * from, size_type n, value_type * to ) nsstsv_noexcept
+    {
+        for ( size_type i = 0; i < n; ++i )
+        {
+            ::new( to + i ) value_type( std::move( from[i] ) );
+            from[i].~value_type();
+        }
+    }
+
+    static void destroy( value_type * data, size_type n ) nsstsv_noexcept
+    {
+        for ( size_type i = 0; i < n; ++i )
+        {
+            data[i].~value_type();
+        }
+    }
+
+    void release() nsstsv_noexcept
+    {
+        clear();
+        deallocate_spilled();
+    }
+
+    // precondition: this is empty and inline
+
+    void adopt( accumulated_status & other ) nsstsv_noexcept
+    {
+        if ( other.is_inline() )
+        {
+            relocate( other.m_data, other.m_size, m_data );
+        }
+        else
+        {
+            m_data = other.m_data;
+            m_capacity = other.m_capacity;
+            other.m_data = other.inline_data();
+            other.m_capacity = N;
+        }
+        m_size = other.m_size;
+        other.m_size = 0;
+    }
+
+    value_type * m_data;
+    size_type m_size;
+    size_type m_capacity;
+    alignas( S ) unsigned char m_inline[ N * sizeof(S) ];
+};
+
+template< typename S, std::size_t N >
+constexpr std::size_t accumulated_status<S, N>::inline_capacity;
+
+// Whether append_failure() keeps the value of a status_value:
+
+enum class partial_value { keep, drop };
+
+// Append failure to the accumulated status, keep or drop the (partial) value:
+
+template< typename S, std::size_t N, typename V, typename F >
+status_value< accumulated_status<S, N>, V >
+append_failure( status_value< accumulated_status<S, N>, V > && sv, F && failure, partial_value mode = partial_value::keep )
+{
+    accumulated_status<S, N> status( std::move( sv ).status() );
+    status.emplace_back( std::forward<F>( failure ) );
+
+    if ( sv.has_value() && mode == partial_value::keep )
+        return { std::move( status ), std::move( sv ).value() };
+
+    return { std::move( status ) };
+}
+
+template< typename S, std::size_t N, typename F >
+status_value< accumulated_status<S, N>, void >
+append_failure( status_value< accumulated_status<S, N>, void > && sv, F && failure )
+{
+    accumulated_status<S, N> status( std::move( sv ).status() );
+    status.emplace_back( std::forward<F>( failure ) );
+
+    return { std::move( status ) };
+}
+
+// Context added to a status while it propagates: static text, or a copy of
+// text of up to nsstsv_CONFIG_CONTEXT_TEXT_SIZE characters:
+
+class context_frame
+{
+public:
+    typedef unsigned char size_type;
+
+    enum : std::size_t { text_capacity = nsstsv_CONFIG_CONTEXT_TEXT_SIZE };
+
+    static_assert( text_capacity <= 255, "context_frame: nsstsv_CONFIG_CONTEXT_TEXT_SIZE shall not exceed 255, the greatest size the frame holds" );
+
+    context_frame() nsstsv_noexcept
+    : m_static( "" )
+    , m_size( 0 )
+    , m_text()
+    {}
+
+    // text must outlive the frame, e.g. a string literal:
+
+    static context_frame from_static( char const * text ) nsstsv_noexcept
+    {
+        context_frame frame;
+        frame.m_static = text;
+        return frame;
+    }
+
+    // copy of text, truncated to text_capacity characters:
+
+    static context_frame from_copy( char const * text, std::size_t size ) nsstsv_noexcept
+    {
+        if ( size > text_capacity )
+            size = text_capacity;
+
+        context_frame frame;
+        frame.m_static = nullptr;
+        frame.m_size = static_cast<size_type>( size );
+        std::memcpy( frame.m_text, text, size );
+        return frame;
+    }
+
+    static context_frame from_copy( char const * text ) nsstsv_noexcept
+    {
+        return from_copy( text, std::strlen( text ) );
+    }
+
+    char const * data() const nsstsv_noexcept
+    {
+        return m_static != nullptr ? m_static : m_text;
+    }
+
+    std::size_t size() const nsstsv_noexcept
+    {
+        return m_static != nullptr ? std::strlen( m_static ) : m_size;
+    }
+
+private:
+    char const * m_static;
+    size_type m_size;
+    char m_text[ text_capacity ];
+};
+
+// Status with a bounded inline stack of up to N context frames:
+//
+// Past N frames, the innermost N/2 and the outermost N - N/2 frames are kept
+// and the frames between them are counted. The frames are held inline, so
+// every status_value that carries a context_status is N * sizeof(context_frame)
+// bytes larger, about 40 bytes per frame with the default text size, also on
+// success. Only the frames in use are copied or moved.
+
+template< typename S, std::size_t N = 8 >
+class context_status
+{
+    static_assert( N > 0, "context_status: depth must be at least one" );
+
+public:
+    typedef S status_type;
+    typedef std::size_t size_type;
+
+    static constexpr size_type max_depth = N;
+
+    // constructors
+
+    context_status()
+    : m_status()
+    , m_depth( 0 )
+    , m_dropped( 0 )
+    , m_oldest( 0 )
+    {}
+
+    context_status( status_type s )
+    : m_status( std::move( s ) )
+    , m_depth( 0 )
+    , m_dropped( 0 )
+    , m_oldest( 0 )
+    {}
+
+    // copy only the frames in use:
+
+    context_status( context_status const & other )
+    : m_status( other.m_status )
+    , m_depth( other.m_depth )
+    , m_dropped( other.m_dropped )
+    , m_oldest( other.m_oldest )
+    {
+        std::memcpy( &m_frames, &other.m_frames, m_depth * sizeof( context_frame ) );
+    }
+
+    context_status( context_status && other )
+    : m_status( std::move( other.m_status ) )
+    , m_depth( other.m_depth )
+    , m_dropped( other.m_dropped )
+    , m_oldest( other.m_oldest )
+    {
+        std::memcpy( &m_frames, &other.m_frames, m_depth * sizeof( context_frame ) );
+    }
+
+    context_status & operator=( context_status const & other )
+    {
+        m_status  = other.m_status;
+        m_depth   = other.m_depth;
+        m_dropped = other.m_dropped;
+        m_oldest  = other.m_oldest;
+        std::memmove( &m_frames, &other.m_frames, m_depth * sizeof( context_frame ) );
+        return *this;
+    }
+
+    context_status & operator=( context_status && other )
+    {
+        m_status  = std::move( other.m_status );
+        m_depth   = other.m_depth;
+        m_dropped = other.m_dropped;
+        m_oldest  = other.m_oldest;
+        std::memmove( &m_frames, &other.m_frames, m_depth * sizeof( context_frame ) );
+        return *this;
+    }
+
+    // modifiers; when full, the frame replaces the oldest of the outer frames:
+
+    void push_context( context_frame const & frame ) nsstsv_noexcept
+    {
+        if ( m_depth < N )
+        {
+            ::new( frames() + m_depth++ ) context_frame( frame );
+        }
+        else
+        {
+            frames()[ inner_depth + m_oldest ] = frame;
+            m_oldest = ( m_oldest + 1 ) % outer_depth;
+            ++m_dropped;
+        }
+    }
+
+    void push_context( char const * static_text ) nsstsv_noexcept
+    {
+        push_context( context_frame::from_static( static_text ) );
+    }
+
+    void push_context_copy( char const * text, std::size_t size ) nsstsv_noexcept
+    {
+        push_context( context_frame::from_copy( text, size ) );
+    }
+
+    void push_context_copy( char const * text ) nsstsv_noexcept
+    {
+        push_context( context_frame::from_copy( text ) );
+    }
+
+    // observers
+
+    status_type const & status() const nsstsv_noexcept
+    {
+        return m_status;
+    }
+
+    size_type depth() const nsstsv_noexcept
+    {
+        return m_depth;
+    }
+
+    size_type dropped() const nsstsv_noexcept
+    {
+        return m_dropped;
+    }
+
+    // frame at pos of the frames kept, 0 being the innermost; the dropped
+    // frames lie between positions N/2 - 1 and N/2:
+
+    context_frame const & frame( size_type pos ) const nsstsv_noexcept
+    {
+        return pos < inner_depth ? frames()[pos] : frames()[ inner_depth + ( m_oldest + pos - inner_depth ) % outer_depth ];
+    }
+
+    // write context outermost first, followed by the status, e.g.:
+    // "in file y: (2 more): while parsing field x: status"
+
+    template< typename Stream >
+    Stream & render( Stream & os ) const
+    {
+        for ( size_type i = m_depth; ; --i )
+        {
+            if ( i == inner_depth && m_dropped > 0 )
+                os << "(" << m_dropped << " more): ";
+
+            if ( i == 0 )
+                break;
+
+            context_frame const & f = frame( i - 1 );
+            write_text( os, f.data(), f.size() );
+            os << ": ";
+        }
+        return os << m_status;
+    }
+
+    template< typename C, typename T >
+    friend std::basic_ostream<C, T> & operator<<( std::basic_ostream<C, T> & os, context_status const & cs )
+    {
+        return cs.render( os );
+    }
+
+private:
+    static_assert( std::is_trivially_copyable<context_frame>::value, "context_status: frames are copied bytewise" );
+
+    // write the text of a frame as is to a narrow stream, widened to another:
+
+    template< typename T >
+    static void write_text( std::basic_ostream<char, T> & os, char const * text, std::size_t size )
+    {
+        os.write( text, static_cast<std::streamsize>( size ) );
+    }
+
+    template< typename C, typename T >
+    static void write_text( std::basic_ostream<C, T> & os, char const * text, std::size_t size )
+    {
+        for ( std::size_t i = 0; i < size; ++i )
+            os.put( os.widen( text[i] ) );
+    }
+
+    static constexpr size_type inner_depth = N / 2;
+    static constexpr size_type outer_depth = N - N / 2;
+
+    context_frame * frames() nsstsv_noexcept
+    {
+        return reinterpret_cast<context_frame *>( &m_frames );
+    }
+
+    context_frame const * frames() const nsstsv_noexcept
+    {
+        return reinterpret_cast<context_frame const *>( &m_frames );
+    }
+
+    status_type m_status;
+    size_type m_depth;
+    size_type m_dropped;
+    size_type m_oldest;
+    alignas( context_frame ) unsigned char m_frames[ N * sizeof(context_frame) ];
+};
+
+template< typename S, std::size_t N >
+constexpr std::size_t context_status<S, N>::max_depth;
+
+// Add context to the status of sv if it has no value, in place:
+
+template< typename S, std::size_t N, typename V >
+status_value< context_status<S, N>, V >
+with_context( status_value< context_status<S, N>, V > && sv, char const * static_text )
+{
+    if ( ! sv.has_value() )
+    {
+        context_status<S, N> && status = std::move( sv ).status();
+        status.push_context( static_text );
+    }
+    return std::move( sv );
+}
+
+template< typename S, std::size_t N, typename V >
+status_value< context_status<S, N>, V >
+with_context_copy( status_value< context_status<S, N>, V > && sv, char const * text, std::size_t size )
+{
+    if ( ! sv.has_value() )
+    {
+        context_status<S, N> && status = std::move( sv ).status();
+        status.push_context_copy( text, size );
+    }
+    return std::move( sv );
+}
+
+namespace status_value_detail {
+
+// Index sequences:
+
+#if nsstsv_CPP14_000
+
+using std::index_sequence;
+using std::make_index_sequence;
+
+#else // nsstsv_CPP14_000
+
+template< std::size_t... I >
+struct index_sequence {};
+
+template< std::size_t N, std::size_t... I >
+struct make_index_sequence_impl : make_index_sequence_impl< N - 1, N - 1, I... > {};
+
+template< std::size_t... I >
+struct make_index_sequence_impl< 0, I... >
+{
+    typedef index_sequence<I...> type;
+};
+
+template< std::size_t N >
+using make_index_sequence = typename make_index_sequence_impl<N>::type;
+
+#endif // nsstsv_CPP14_000
+
+constexpr std::size_t sum_of() noexcept
+{
+    return 0;
+}
+
+template< typename... Rest >
+constexpr std::size_t sum_of( std::size_t first, Rest... rest ) noexcept
+{
+    return first + sum_of( rest... );
+}
+
+// Order of the elements of packed<Ts...>: by decreasing alignment, stable.
+// As every size is a multiple of its alignment, this order needs no padding
+// between elements, only at the end.
+
+template< typename... Ts >
+struct packed_order
+{
+    template< std::size_t... J >
+    static constexpr std::size_t alignment_of( std::size_t i, index_sequence<J...> ) noexcept
+    {
+        return sum_of( ( J == i ? alignof(Ts) : 0 )... );
     }
 
-    value_type & operator *() &
+    template< std::size_t... J >
+    static constexpr std::size_t position_of( std::size_t i, std::size_t align, index_sequence<J...> ) noexcept
     {
-        return value();
+        return sum_of( ( alignof(Ts) > align || ( alignof(Ts) == align && J < i ) ? 1u : 0u )... );
     }
 
-    value_type const && operator*() const &&
+    // Position in packed order of the element with index i:
+
+    static constexpr std::size_t position( std::size_t i ) noexcept
     {
-        return std::move( value() );
+        return position_of( i, alignment_of( i, make_index_sequence<sizeof...(Ts)>() ), make_index_sequence<sizeof...(Ts)>() );
     }
 
-    value_type && operator*() &&
+    template< std::size_t... J >
+    static constexpr std::size_t index_of( std::size_t p, index_sequence<J...> ) noexcept
     {
-        return std::move( value() );
+        return sum_of( ( position( J ) == p ? J : 0 )... );
+    }
+
+    // Index of the element at position p in packed order:
+
+    static constexpr std::size_t index( std::size_t p ) noexcept
+    {
+        return index_of( p, make_index_sequence<sizeof...(Ts)>() );
+    }
+};
+
+// Tag to construct the nodes of packed<> from their elements in packed order:
+
+struct packed_init_t {};
+
+// Elements in packed order, nested:
+
+template< typename... Ts >
+struct packed_node;
+
+template< typename T >
+struct packed_node< T >
+{
+    T head;
+
+    packed_node() = default;
+
+    template< typename U >
+    constexpr packed_node( packed_init_t, U && u )
+        : head( std::forward<U>( u ) ) {}
+};
+
+template< typename T, typename... Rest >
+struct packed_node< T, Rest... >
+{
+    T head;
+    packed_node< Rest... > tail;
+
+    packed_node() = default;
+
+    template< typename U, typename... Us >
+    constexpr packed_node( packed_init_t tag, U && u, Us&&... us )
+        : head( std::forward<U>( u ) ), tail( tag, std::forward<Us>( us )... ) {}
+};
+
+// Element at position P of the nodes:
+
+template< std::size_t P >
+struct packed_access
+{
+    template< typename Node >
+    static constexpr auto get( Node & node ) noexcept -> decltype( packed_access<P - 1>::get( node.tail ) )
+    {
+        return packed_access<P - 1>::get( node.tail );
+    }
+};
+
+template<>
+struct packed_access< 0 >
+{
+    template< typename Node >
+    static constexpr auto get( Node & node ) noexcept -> decltype( ( node.head ) )
+    {
+        return node.head;
+    }
+};
+
+template< typename Ts, typename Ps >
+struct packed_nodes_of;
+
+template< typename... Ts, std::size_t... P >
+struct packed_nodes_of< packed_node< Ts... >, index_sequence<P...> >
+{
+    typedef packed_node< typename std::tuple_element< packed_order<Ts...>::index( P ), std::tuple<Ts...> >::type... > type;
+};
+
+// Whether all of B... hold:
+
+template< bool... B >
+struct bool_pack {};
+
+template< bool... B >
+struct all_of : std::is_same< bool_pack<true, B...>, bool_pack<B..., true> > {};
+
+// Whether packed<> is constructed from a single packed<> of the same type:
+
+template< typename P, typename... Us >
+struct is_packed_copy : std::false_type {};
+
+template< typename P, typename U >
+struct is_packed_copy< P, U > : std::is_same< P, typename std::decay<U>::type > {};
+
+} // namespace status_value_detail
+
+// Several values, such as the results of a function, stored without padding
+// between them; access is by the original index:
+//
+// packed<char, double, int> occupies 16 bytes, where the equivalent struct
+// occupies 24. Elements are object types. Supports structured bindings.
+
+template< typename... Ts >
+class packed
+{
+    static_assert( sizeof...(Ts) > 0, "packed: requires at least one element" );
+
+    template< std::size_t I >
+    using position = std::integral_constant< std::size_t, status_value_detail::packed_order<Ts...>::position( I ) >;
+
+public:
+    template< std::size_t I >
+    using element_type = typename std::tuple_element< I, std::tuple<Ts...> >::type;
+
+    static constexpr std::size_t size() noexcept
+    {
+        return sizeof...(Ts);
+    }
+
+    // Value-initialize elements:
+
+    constexpr packed()
+        : m_nodes() {}
+
+    template< typename... Us, typename std::enable_if<
+        sizeof...(Us) == sizeof...(Ts) && ! status_value_detail::is_packed_copy<packed, Us...>::value
+        && status_value_detail::all_of< std::is_constructible<Ts, Us &&>::value... >::value, int >::type = 0 >
+    constexpr packed( Us&&... us )
+        : packed( std::forward_as_tuple( std::forward<Us>( us )... ), status_value_detail::make_index_sequence<sizeof...(Ts)>() ) {}
+
+    template< std::size_t I >
+    nsstsv_constexpr14 element_type<I> & get() & noexcept
+    {
+        return status_value_detail::packed_access< position<I>::value >::get( m_nodes );
+    }
+
+    template< std::size_t I >
+    constexpr element_type<I> const & get() const & noexcept
+    {
+        return status_value_detail::packed_access< position<I>::value >::get( m_nodes );
+    }
+
+    template< std::size_t I >
+    nsstsv_constexpr14 element_type<I> && get() && noexcept
+    {
+        return std::move( status_value_detail::packed_access< position<I>::value >::get( m_nodes ) );
+    }
+
+    template< std::size_t I >
+    constexpr element_type<I> const && get() const && noexcept
+    {
+        return std::move( status_value_detail::packed_access< position<I>::value >::get( m_nodes ) );
     }
 
 private:
-    using storage_type = status_value_detail::storage_t<status_type, value_type>;
+    template< typename Refs, std::size_t... P >
+    constexpr packed( Refs && refs, status_value_detail::index_sequence<P...> )
+        : m_nodes( status_value_detail::packed_init_t(),
+            std::get< status_value_detail::packed_order<Ts...>::index( P ) >( std::move( refs ) )... ) {}
 
-    storage_type contained;
-    status_type m_status;
-    bool m_has_value;
+    typename status_value_detail::packed_nodes_of<
+        status_value_detail::packed_node<Ts...>, status_value_detail::make_index_sequence<sizeof...(Ts)> >::type m_nodes;
+};
+
+template< std::size_t I, typename... Ts >
+nsstsv_constexpr14 typename packed<Ts...>::template element_type<I> & get( packed<Ts...> & p ) noexcept
+{
+    return p.template get<I>();
+}
+
+template< std::size_t I, typename... Ts >
+constexpr typename packed<Ts...>::template element_type<I> const & get( packed<Ts...> const & p ) noexcept
+{
+    return p.template get<I>();
+}
+
+template< std::size_t I, typename... Ts >
+nsstsv_constexpr14 typename packed<Ts...>::template element_type<I> && get( packed<Ts...> && p ) noexcept
+{
+    return std::move( p ).template get<I>();
+}
+
+template< typename... Ts >
+constexpr packed< typename std::decay<Ts>::type... > make_packed( Ts&&... values )
+{
+    return packed< typename std::decay<Ts>::type... >( std::forward<Ts>( values )... );
+}
+
+namespace status_value_detail {
+
+// Access to the value of a status_value that is known to be engaged, without
+// checking again; other types such as the element references of
+// status_value_vector use their own value():
+
+struct unchecked_access
+{
+    template< typename S, typename V >
+    static typename status_value<S, V>::value_type const & value( status_value<S, V> const & sv ) nsstsv_noexcept
+    {
+        return sv.contained.value();
+    }
+
+    template< typename S, typename V >
+    static typename status_value<S, V>::value_type & value( status_value<S, V> & sv ) nsstsv_noexcept
+    {
+        return sv.contained.value();
+    }
+
+    template< typename S, typename V >
+    static typename status_value<S, V>::value_type && value( status_value<S, V> && sv ) nsstsv_noexcept
+    {
+        return std::move( sv.contained ).value();
+    }
+
+    template< typename S, typename V >
+    static V & value( status_value<S, V &> const & sv ) nsstsv_noexcept
+    {
+        return *sv.m_ptr;
+    }
+
+    template< typename S, typename V >
+    static V & value( status_value<S, V &> & sv ) nsstsv_noexcept
+    {
+        return *sv.m_ptr;
+    }
+
+    template< typename S, typename V >
+    static V & value( status_value<S, V &> && sv ) nsstsv_noexcept
+    {
+        return *sv.m_ptr;
+    }
+
+    template< typename T >
+    static auto value( T && t ) -> decltype( std::forward<T>( t ).value() )
+    {
+        return std::forward<T>( t ).value();
+    }
+};
+
+} // namespace status_value_detail
+
+namespace status_value_detail {
+
+// Status type and the type of value to combine of a status_value; a referred
+// value is combined by reference:
+
+template< typename SV >
+struct combined_parts;
+
+template< typename S, typename V >
+struct combined_parts< status_value<S, V> >
+{
+    typedef S status_type;
+    typedef typename std::conditional< std::is_reference<V>::value, V, typename status_value<S, V>::value_type >::type value_type;
 };
 
+template< template< typename... > class Tuple, typename SV, typename... SVs >
+struct combined_result
+{
+    typedef typename combined_parts< typename std::decay<SV>::type >::status_type status_type;
+
+    static_assert( all_of< std::is_same< status_type, typename combined_parts< typename std::decay<SVs>::type >::status_type >::value... >::value
+        , "combine: all status_values shall have the same status type" );
+
+    typedef status_value< status_type, Tuple<
+        typename combined_parts< typename std::decay<SV>::type >::value_type
+      , typename combined_parts< typename std::decay<SVs>::type >::value_type... > > type;
+};
+
+// A T constructed from the arguments, to construct a value from_invoke:
+
+template< typename T >
+struct construct_from
+{
+    template< typename... Args >
+    T operator()( Args&&... args ) const
+    {
+        return T( std::forward<Args>( args )... );
+    }
+};
+
+// All engaged: the status of the first and the tuple of all values, built in
+// place from the tuple of references to the status_values, so that each value
+// is moved once, without moving the tuple in C++17 and later:
+
+template< typename Result, typename All, std::size_t... I >
+Result combine_values( All & all, index_sequence<I...> )
+{
+    typedef typename Result::value_type values_type;
+
+    return Result( std::forward< typename std::tuple_element<0, All>::type >( std::get<0>( all ) ).status(), from_invoke, construct_from<values_type>()
+        , unchecked_access::value( std::forward< typename std::tuple_element<I, All>::type >( std::get<I>( all ) ) )... );
+}
+
+// Like a chain of ifs, return the status of the first failure, if any:
+
+template< typename Result, typename All >
+Result combine_checked( All & all )
+{
+    return combine_values<Result>( all, make_index_sequence< std::tuple_size<All>::value >() );
+}
+
+template< typename Result, typename All, typename SV, typename... Rest >
+Result combine_checked( All & all, SV && sv, Rest &&... rest )
+{
+    if ( ! sv.has_value() )
+        return Result( std::forward<SV>( sv ).status() );
+
+    return combine_checked<Result>( all, std::forward<Rest>( rest )... );
+}
+
+// Index of the most severe failure, or -1 if none; the first of equally severe ones:
+
+template< typename Less, typename S >
+int most_severe_failure( Less &, int, S const *, int worst )
+{
+    return worst;
+}
+
+template< typename Less, typename S, typename SV, typename... Rest >
+int most_severe_failure( Less & less, int index, S const * worst_status, int worst, SV const & sv, Rest const &... rest )
+{
+    if ( ! sv.has_value() && ( worst_status == nullptr || less( *worst_status, sv.status() ) ) )
+        return most_severe_failure( less, index + 1, &sv.status(), index, rest... );
+
+    return most_severe_failure( less, index + 1, worst_status, worst, rest... );
+}
+
+// The status at index, moved from an rvalue:
+
+template< typename Result, typename SV >
+Result status_at( int, SV && sv )
+{
+    return Result( std::forward<SV>( sv ).status() );
+}
+
+template< typename Result, typename SV, typename Next, typename... Rest >
+Result status_at( int index, SV && sv, Next && next, Rest &&... rest )
+{
+    if ( index == 0 )
+        return Result( std::forward<SV>( sv ).status() );
+
+    return status_at<Result>( index - 1, std::forward<Next>( next ), std::forward<Rest>( rest )... );
+}
+
+} // namespace status_value_detail
+
+// Combine the values of status_values into a single status_value of a tuple of
+// them, or of another variadic aggregate such as packed<>, moving each value
+// once:
+//
+// If all are engaged, the result has the status of the first; otherwise it has
+// the status of the first that is not, as a chain of ifs would return. Values
+// and statuses are moved from rvalue arguments and copied from lvalues.
+
+template< template< typename... > class Tuple = std::tuple, typename SV, typename... SVs >
+typename status_value_detail::combined_result<Tuple, SV, SVs...>::type
+combine( SV && sv, SVs &&... svs )
+{
+    typedef typename status_value_detail::combined_result<Tuple, SV, SVs...>::type result;
+
+    std::tuple<SV &&, SVs &&...> all( std::forward<SV>( sv ), std::forward<SVs>( svs )... );
+
+    return status_value_detail::combine_checked<result>( all, std::forward<SV>( sv ), std::forward<SVs>( svs )... );
+}
+
+// Combine as above, with the status of the most severe failure, if any, as
+// ordered by less( a, b ), true if a is less severe than b. Of equally severe
+// failures, the status of the first is taken:
+
+template< template< typename... > class Tuple = std::tuple, typename Less, typename SV, typename... SVs >
+typename status_value_detail::combined_result<Tuple, SV, SVs...>::type
+combine_by( Less less, SV && sv, SVs &&... svs )
+{
+    typedef typename status_value_detail::combined_result<Tuple, SV, SVs...>::type result;
+
+    int const worst = status_value_detail::most_severe_failure( less, 0, static_cast<typename result::status_type const *>( nullptr ), -1, sv, svs... );
+
+    if ( worst >= 0 )
+        return status_value_detail::status_at<result>( worst, std::forward<SV>( sv ), std::forward<SVs>( svs )... );
+
+    std::tuple<SV &&, SVs &&...> all( std::forward<SV>( sv ), std::forward<SVs>( svs )... );
+
+    return status_value_detail::combine_values<result>( all, status_value_detail::make_index_sequence<1 + sizeof...(SVs)>() );
+}
+
+#if nsstsv_HAVE_STD_OPTIONAL
+
+// Conversions to and from std::optional, moving the value exactly once:
+
+template< typename S, typename V >
+std::optional< typename status_value<S, V>::value_type > to_optional( status_value<S, V> && sv )
+{
+    using optional_type = std::optional< typename status_value<S, V>::value_type >;
+
+    return sv ? optional_type( std::in_place, std::move( sv ).value() ) : optional_type();
+}
+
+template< typename S, typename V >
+std::optional< typename status_value<S, V>::value_type > to_optional( status_value<S, V> const & sv )
+{
+    using optional_type = std::optional< typename status_value<S, V>::value_type >;
+
+    return sv ? optional_type( std::in_place, sv.value() ) : optional_type();
+}
+
+template< typename S, typename V >
+status_value<S, V> from_optional( std::optional<V> && opt, S success, S nullopt_status )
+{
+    return opt ? status_value<S, V>( std::move( success ), std::move( *opt ) ) : status_value<S, V>( std::move( nullopt_status ) );
+}
+
+#endif // nsstsv_HAVE_STD_OPTIONAL
+
+#if nsstsv_HAVE_STD_EXPECTED
+
+// Conversions to and from std::expected, moving the value exactly once;
+// map converts the status to the error, or the error to the status:
+
+template< typename S, typename V, typename Map >
+auto to_expected( status_value<S, V> && sv, Map && map )
+    -> std::expected< typename status_value<S, V>::value_type, std::decay_t< std::invoke_result_t<Map, S &&> > >
+{
+    using expected_type = std::expected< typename status_value<S, V>::value_type, std::decay_t< std::invoke_result_t<Map, S &&> > >;
+
+    return sv ? expected_type( std::in_place, std::move( sv ).value() )
+              : expected_type( std::unexpect, status_value_detail::invoke( std::forward<Map>( map ), std::move( sv ).status() ) );
+}
+
+template< typename S, typename V >
+std::expected< typename status_value<S, V>::value_type, S > to_expected( status_value<S, V> && sv )
+{
+    using expected_type = std::expected< typename status_value<S, V>::value_type, S >;
+
+    return sv ? expected_type( std::in_place, std::move( sv ).value() )
+              : expected_type( std::unexpect, std::move( sv ).status() );
+}
+
+template< typename S, typename Map >
+auto to_expected( status_value<S, void> && sv, Map && map )
+    -> std::expected< void, std::decay_t< std::invoke_result_t<Map, S &&> > >
+{
+    using expected_type = std::expected< void, std::decay_t< std::invoke_result_t<Map, S &&> > >;
+
+    return sv ? expected_type()
+              : expected_type( std::unexpect, status_value_detail::invoke( std::forward<Map>( map ), std::move( sv ).status() ) );
+}
+
+template< typename S >
+std::expected< void, S > to_expected( status_value<S, void> && sv )
+{
+    using expected_type = std::expected< void, S >;
+
+    return sv ? expected_type()
+              : expected_type( std::unexpect, std::move( sv ).status() );
+}
+
+template< typename S, typename V, typename E, typename Map >
+status_value<S, V> from_expected( std::expected<V, E> && exp, S success, Map && map )
+{
+    return exp ? status_value<S, V>( std::move( success ), std::move( *exp ) )
+               : status_value<S, V>( status_value_detail::invoke( std::forward<Map>( map ), std::move( exp ).error() ) );
+}
+
+template< typename S, typename V, typename E >
+status_value<S, V> from_expected( std::expected<V, E> && exp, S success )
+{
+    return exp ? status_value<S, V>( std::move( success ), std::move( *exp ) )
+               : status_value<S, V>( S( std::move( exp ).error() ) );
+}
+
+#endif // nsstsv_HAVE_STD_EXPECTED
+
 } // namespace nonstd
 
+namespace std {
+
+// status_value uses an allocator if its status or value does:
+
+template< typename S, typename V, typename Alloc >
+struct uses_allocator< nonstd::status_value<S, V>, Alloc >
+    : integral_constant< bool, uses_allocator<S, Alloc>::value
+        || uses_allocator< typename nonstd::status_value<S, V>::value_type, Alloc >::value > {};
+
+// status_value of a reference does not construct with an allocator:
+
+template< typename S, typename V, typename Alloc >
+struct uses_allocator< nonstd::status_value<S, V &>, Alloc > : false_type {};
+
+// Tuple-like access to packed<>, for structured bindings:
+
+template< typename... Ts >
+struct tuple_size< nonstd::packed<Ts...> > : integral_constant< size_t, sizeof...(Ts) > {};
+
+template< size_t I, typename... Ts >
+struct tuple_element< I, nonstd::packed<Ts...> >
+{
+    typedef typename nonstd::packed<Ts...>::template element_type<I> type;
+};
+
+} // namespace std
+
 #endif // NONSTD_STATUS_VALUE_HPP
@@ -0,0 +1,2489 @@
+// Copyright 2016-2022 by Martin Moene
+//
+// This version targets C++11 and later.
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Batches of status_value: status_value_vector, sparse_status_vector, the
+// batch kernels, grouping by status, pipelines, collecting a range and the
+// range adaptors. Opt-in, on top of nonstd/status_value.hpp.
+
+#ifndef NONSTD_STATUS_VALUE_BATCH_HPP
+#define NONSTD_STATUS_VALUE_BATCH_HPP
+
+#include "status_value.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <vector>
+
+#if nsstsv_HAVE_STD_POPCOUNT
+# include <bit>
+#endif
+
+#if nsstsv_HAVE_STD_RANGES
+# include <ranges>
+#endif
+
+#if nsstsv_HAVE_X86_SIMD_DISPATCH
+# include <immintrin.h>
+#endif
+
+namespace nonstd {
+
+namespace status_value_detail {
+
+struct batch_codec;
+struct batch_partition;
+
+} // namespace status_value_detail
+
+namespace status_value_detail {
+
+// Number of bits set:
+
+inline nsstsv_constexpr14 int popcount( std::uint64_t x ) nsstsv_noexcept
+{
+#if nsstsv_HAVE_STD_POPCOUNT
+    return std::popcount( x );
+#elif defined( __GNUC__ ) || defined( __clang__ )
+    return __builtin_popcountll( x );
+#else
+    x = x - ( ( x >> 1 ) & 0x5555555555555555ull );
+    x = ( x & 0x3333333333333333ull ) + ( ( x >> 2 ) & 0x3333333333333333ull );
+    x = ( x + ( x >> 4 ) ) & 0x0f0f0f0f0f0f0f0full;
+    return static_cast<int>( ( x * 0x0101010101010101ull ) >> 56 );
+#endif
+}
+
+} // namespace status_value_detail
+
+// Sequence of status_value<S, V>, stored as structure of arrays:
+//
+// Values, statuses and a bitmap of engaged elements are kept in separate
+// arrays, so that a scan of values or of engagement touches only the memory
+// it needs. Value slots of failed elements hold no object. Elements are
+// accessed, also via the iterators, through proxies that read like a
+// status_value.
+
+template< typename S, typename V >
+class status_value_vector
+{
+    static_assert( std::is_object<V>::value, "status_value_vector: value shall be an object type" );
+
+public:
+    typedef S status_type;
+    typedef V value_type;
+    typedef std::size_t size_type;
+    typedef std::uint64_t word_type;
+
+    static constexpr size_type word_bits = 64;
+
+    // Element proxy:
+
+    template< typename Vector >
+    class basic_reference
+    {
+    public:
+        typedef typename std::conditional< std::is_const<Vector>::value, value_type const, value_type >::type element_type;
+
+        basic_reference( Vector & vec, size_type pos ) nsstsv_noexcept
+        : m_vec( &vec ), m_pos( pos ) {}
+
+        basic_reference( basic_reference const & ) = default;
+
+        // assign the referred element, not the proxy:
+
+        basic_reference const & operator=( basic_reference const & other ) const
+        {
+            return *this = static_cast< status_value<S, V> >( other );
+        }
+
+        // assign the status and value, if any, of sv:
+
+        basic_reference const & operator=( status_value<S, V> const & sv ) const
+        {
+            m_vec->assign( m_pos, sv );
+            return *this;
+        }
+
+        basic_reference const & operator=( status_value<S, V> && sv ) const
+        {
+            m_vec->assign( m_pos, std::move( sv ) );
+            return *this;
+        }
+
+        // copy of the element:
+
+        operator status_value<S, V>() const
+        {
+            return has_value() ? status_value<S, V>( status(), value() ) : status_value<S, V>( status() );
+        }
+
+        status_type const & status() const nsstsv_noexcept
+        {
+            return m_vec->status( m_pos );
+        }
+
+        bool has_value() const nsstsv_noexcept
+        {
+            return m_vec->has_value( m_pos );
+        }
+
+        explicit operator bool() const nsstsv_noexcept
+        {
+            return has_value();
+        }
+
+        element_type & value() const
+        {
+            return m_vec->value( m_pos );
+        }
+
+        element_type & operator*() const
+        {
+            return value();
+        }
+
+        element_type * operator->() const
+        {
+            return &value();
+        }
+
+    private:
+        Vector * m_vec;
+        size_type m_pos;
+    };
+
+    typedef basic_reference< status_value_vector > reference;
+    typedef basic_reference< status_value_vector const > const_reference;
+
+    // Iterator, random access; dereferences to an element proxy, which is
+    // also its value type, as status_value<S, V> is not copyable:
+
+    template< typename Vector >
+    class basic_iterator
+    {
+    public:
+        typedef std::random_access_iterator_tag iterator_category;
+        typedef basic_reference< Vector > value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef void pointer;
+        typedef basic_reference< Vector > reference;
+
+        basic_iterator() nsstsv_noexcept
+        : m_vec( nullptr ), m_pos( 0 ) {}
+
+        basic_iterator( Vector & vec, size_type pos ) nsstsv_noexcept
+        : m_vec( &vec ), m_pos( pos ) {}
+
+        // iterator to const_iterator:
+
+        template< typename Other
+            , typename std::enable_if< std::is_const<Vector>::value && std::is_same<Other, typename std::remove_const<Vector>::type>::value, int >::type = 0
+        >
+        basic_iterator( basic_iterator<Other> const & other ) nsstsv_noexcept
+        : m_vec( other.m_vec ), m_pos( other.m_pos ) {}
+
+        reference operator*() const nsstsv_noexcept
+        {
+            return reference( *m_vec, m_pos );
+        }
+
+        reference operator[]( difference_type n ) const nsstsv_noexcept
+        {
+            return reference( *m_vec, m_pos + static_cast<size_type>( n ) );
+        }
+
+        basic_iterator & operator++() nsstsv_noexcept { ++m_pos; return *this; }
+        basic_iterator & operator--() nsstsv_noexcept { --m_pos; return *this; }
+
+        basic_iterator operator++( int ) nsstsv_noexcept { basic_iterator tmp = *this; ++m_pos; return tmp; }
+        basic_iterator operator--( int ) nsstsv_noexcept { basic_iterator tmp = *this; --m_pos; return tmp; }
+
+        basic_iterator & operator+=( difference_type n ) nsstsv_noexcept { m_pos += static_cast<size_type>( n ); return *this; }
+        basic_iterator & operator-=( difference_type n ) nsstsv_noexcept { m_pos -= static_cast<size_type>( n ); return *this; }
+
+        friend basic_iterator operator+( basic_iterator it, difference_type n ) nsstsv_noexcept { return it += n; }
+        friend basic_iterator operator+( difference_type n, basic_iterator it ) nsstsv_noexcept { return it += n; }
+        friend basic_iterator operator-( basic_iterator it, difference_type n ) nsstsv_noexcept { return it -= n; }
+
+        friend difference_type operator-( basic_iterator const & a, basic_iterator const & b ) nsstsv_noexcept
+        {
+            return static_cast<difference_type>( a.m_pos ) - static_cast<difference_type>( b.m_pos );
+        }
+
+        friend bool operator==( basic_iterator const & a, basic_iterator const & b ) nsstsv_noexcept { return a.m_pos == b.m_pos; }
+        friend bool operator!=( basic_iterator const & a, basic_iterator const & b ) nsstsv_noexcept { return a.m_pos != b.m_pos; }
+        friend bool operator< ( basic_iterator const & a, basic_iterator const & b ) nsstsv_noexcept { return a.m_pos <  b.m_pos; }
+        friend bool operator> ( basic_iterator const & a, basic_iterator const & b ) nsstsv_noexcept { return a.m_pos >  b.m_pos; }
+        friend bool operator<=( basic_iterator const & a, basic_iterator const & b ) nsstsv_noexcept { return a.m_pos <= b.m_pos; }
+        friend bool operator>=( basic_iterator const & a, basic_iterator const & b ) nsstsv_noexcept { return a.m_pos >= b.m_pos; }
+
+    private:
+        template< typename Other >
+        friend class basic_iterator;
+
+        Vector * m_vec;
+        size_type m_pos;
+    };
+
+    typedef basic_iterator< status_value_vector > iterator;
+    typedef basic_iterator< status_value_vector const > const_iterator;
+
+    // construction, destruction, assignment:
+
+    status_value_vector() nsstsv_noexcept
+    : m_values( nullptr )
+    , m_size( 0 )
+    , m_capacity( 0 )
+    {}
+
+    status_value_vector( status_value_vector const & other )
+    : status_value_vector()
+    {
+        reserve( other.size() );
+
+        for ( size_type i = 0; i < other.size(); ++i )
+        {
+            if ( other.has_value( i ) )
+                emplace_back( other.status( i ), other.value( i ) );
+            else
+                emplace_back( other.status( i ) );
+        }
+    }
+
+    status_value_vector( status_value_vector && other ) nsstsv_noexcept
+    : status_value_vector()
+    {
+        swap( other );
+    }
+
+    ~status_value_vector()
+    {
+        clear();
+        deallocate( m_values, m_capacity );
+    }
+
+    status_value_vector & operator=( status_value_vector other ) nsstsv_noexcept
+    {
+        swap( other );
+        return *this;
+    }
+
+    void swap( status_value_vector & other ) nsstsv_noexcept
+    {
+        using std::swap;
+
+        swap( m_values  , other.m_values   );
+        swap( m_statuses, other.m_statuses );
+        swap( m_engaged , other.m_engaged  );
+        swap( m_size    , other.m_size     );
+        swap( m_capacity, other.m_capacity );
+    }
+
+    // capacity:
+
+    size_type size() const nsstsv_noexcept
+    {
+        return m_size;
+    }
+
+    bool empty() const nsstsv_noexcept
+    {
+        return m_size == 0;
+    }
+
+    size_type capacity() const nsstsv_noexcept
+    {
+        return m_capacity;
+    }
+
+    void reserve( size_type capacity )
+    {
+        if ( capacity <= m_capacity )
+            return;
+
+        m_statuses.reserve( capacity );
+        m_engaged.reserve( word_count( capacity ) );
+
+        block_guard guard = { this, allocate( capacity ), capacity, 0 };
+
+        relocate_to( guard );
+    }
+
+    // modifiers:
+
+    void push_back( status_value<S, V> const & sv )
+    {
+        if ( sv.has_value() )
+            emplace_back( sv.status(), sv.value() );
+        else
+            emplace_back( sv.status() );
+    }
+
+    void push_back( status_value<S, V> && sv )
+    {
+        if ( sv.has_value() )
+            emplace_back( std::move( sv ).status(), std::move( sv ).value() );
+        else
+            emplace_back( std::move( sv ).status() );
+    }
+
+    // append a failure with status s:
+
+    reference emplace_back( status_type s )
+    {
+        grow();
+        m_statuses.push_back( std::move( s ) );
+        m_engaged.resize( word_count( m_size + 1 ) );
+
+        return reference( *this, m_size++ );
+    }
+
+    // append an element with status s and the value constructed from args:
+
+    template< typename Arg, typename... Args >
+    reference emplace_back( status_type s, Arg && arg, Args&&... args )
+    {
+        if ( m_size == m_capacity )
+            grow_with_value( std::forward<Arg>( arg ), std::forward<Args>( args )... );
+        else
+            ::new( static_cast<void *>( m_values + m_size ) ) value_type( std::forward<Arg>( arg ), std::forward<Args>( args )... );
+
+        slot_guard guard = { m_values + m_size };
+        m_statuses.push_back( std::move( s ) );
+        guard.slot = nullptr;
+
+        m_engaged.resize( word_count( m_size + 1 ) );
+        m_engaged[ m_size / word_bits ] |= bit( m_size );
+
+        return reference( *this, m_size++ );
+    }
+
+    void pop_back()
+    {
+        --m_size;
+
+        if ( has_value( m_size ) )
+            m_values[ m_size ].~value_type();
+
+        m_statuses.pop_back();
+        m_engaged[ m_size / word_bits ] &= ~bit( m_size );
+        m_engaged.resize( word_count( m_size ) );
+    }
+
+    void clear() nsstsv_noexcept
+    {
+        destroy_values();
+        m_statuses.clear();
+        m_engaged.clear();
+        m_size = 0;
+    }
+
+    // element access:
+
+    reference operator[]( size_type pos ) nsstsv_noexcept
+    {
+        return reference( *this, pos );
+    }
+
+    const_reference operator[]( size_type pos ) const nsstsv_noexcept
+    {
+        return const_reference( *this, pos );
+    }
+
+    // iterators:
+
+    iterator begin() nsstsv_noexcept
+    {
+        return iterator( *this, 0 );
+    }
+
+    iterator end() nsstsv_noexcept
+    {
+        return iterator( *this, m_size );
+    }
+
+    const_iterator begin() const nsstsv_noexcept
+    {
+        return const_iterator( *this, 0 );
+    }
+
+    const_iterator end() const nsstsv_noexcept
+    {
+        return const_iterator( *this, m_size );
+    }
+
+    const_iterator cbegin() const nsstsv_noexcept
+    {
+        return begin();
+    }
+
+    const_iterator cend() const nsstsv_noexcept
+    {
+        return end();
+    }
+
+    bool has_value( size_type pos ) const nsstsv_noexcept
+    {
+        return ( m_engaged[ pos / word_bits ] & bit( pos ) ) != 0;
+    }
+
+    status_type const & status( size_type pos ) const nsstsv_noexcept
+    {
+        return m_statuses[ pos ];
+    }
+
+    value_type const & value( size_type pos ) const
+    {
+        if ( ! has_value( pos ) )
+            report_bad_status_value_access( m_statuses[ pos ] );
+
+        return m_values[ pos ];
+    }
+
+    value_type & value( size_type pos )
+    {
+        if ( ! has_value( pos ) )
+            report_bad_status_value_access( m_statuses[ pos ] );
+
+        return m_values[ pos ];
+    }
+
+    // assign the status and value, if any, of sv to the element at pos:
+
+    template< typename SV >
+    void assign( size_type pos, SV && sv )
+    {
+        if ( sv.has_value() )
+        {
+            if ( has_value( pos ) )
+            {
+                m_values[ pos ] = std::forward<SV>( sv ).value();
+            }
+            else
+            {
+                ::new( static_cast<void *>( m_values + pos ) ) value_type( std::forward<SV>( sv ).value() );
+                m_engaged[ pos / word_bits ] |= bit( pos );
+            }
+        }
+        else if ( has_value( pos ) )
+        {
+            m_values[ pos ].~value_type();
+            m_engaged[ pos / word_bits ] &= ~bit( pos );
+        }
+
+        m_statuses[ pos ] = std::forward<SV>( sv ).status();
+    }
+
+    // counts, in O(n/64):
+
+    size_type count_engaged() const nsstsv_noexcept
+    {
+        size_type count = 0;
+
+        for ( word_type word : m_engaged )
+        {
+            count += static_cast<size_type>( status_value_detail::popcount( word ) );
+        }
+        return count;
+    }
+
+    size_type count_failed() const nsstsv_noexcept
+    {
+        return m_size - count_engaged();
+    }
+
+    // the arrays; value slots of failed elements hold no object and bits
+    // beyond size() are zero:
+
+    value_type * values() nsstsv_noexcept
+    {
+        return m_values;
+    }
+
+    value_type const * values() const nsstsv_noexcept
+    {
+        return m_values;
+    }
+
+    status_type const * statuses() const nsstsv_noexcept
+    {
+        return m_statuses.data();
+    }
+
+    word_type const * engaged_words() const nsstsv_noexcept
+    {
+        return m_engaged.data();
+    }
+
+    static constexpr size_type word_count( size_type n ) nsstsv_noexcept
+    {
+        return ( n + word_bits - 1 ) / word_bits;
+    }
+
+private:
+    friend struct status_value_detail::batch_codec;
+    friend struct status_value_detail::batch_partition;
+
+    // Destroy the value in slot unless released:
+
+    struct slot_guard
+    {
+        value_type * slot;
+
+        ~slot_guard()
+        {
+            if ( slot )
+                slot->~value_type();
+        }
+    };
+
+    // Destroy the values moved into the block so far and deallocate it unless released:
+
+    struct block_guard
+    {
+        status_value_vector const * vec;
+        value_type * values;
+        size_type capacity;
+        size_type constructed;
+
+        ~block_guard()
+        {
+            if ( ! values )
+                return;
+
+            while ( constructed-- > 0 )
+            {
+                if ( vec->has_value( constructed ) )
+                    values[ constructed ].~value_type();
+            }
+            deallocate( values, capacity );
+        }
+
+        value_type * release() nsstsv_noexcept
+        {
+            value_type * result = values;
+            values = nullptr;
+            return result;
+        }
+    };
+
+    static constexpr word_type bit( size_type pos ) nsstsv_noexcept
+    {
+        return word_type( 1 ) << ( pos % word_bits );
+    }
+
+    static value_type * allocate( size_type n )
+    {
+        return std::allocator<value_type>().allocate( n );
+    }
+
+    static void deallocate( value_type * p, size_type n ) nsstsv_noexcept
+    {
+        if ( p )
+            std::allocator<value_type>().deallocate( p, n );
+    }
+
+    size_type grown_capacity() const nsstsv_noexcept
+    {
+        return m_capacity < 8 ? 8 : 2 * m_capacity;
+    }
+
+    void grow()
+    {
+        if ( m_size == m_capacity )
+            reserve( grown_capacity() );
+    }
+
+    // grow with the value at size() constructed first, as args may refer to
+    // a current element:
+
+    template< typename... Args >
+    void grow_with_value( Args&&... args )
+    {
+        size_type const capacity = grown_capacity();
+
+        m_statuses.reserve( capacity );
+        m_engaged.reserve( word_count( capacity ) );
+
+        block_guard guard = { this, allocate( capacity ), capacity, 0 };
+
+        ::new( static_cast<void *>( guard.values + m_size ) ) value_type( std::forward<Args>( args )... );
+        slot_guard slot = { guard.values + m_size };
+
+        relocate_to( guard );
+        slot.slot = nullptr;
+    }
+
+    // move the values into the block of guard and make it the storage:
+
+    void relocate_to( block_guard & guard )
+    {
+        for ( ; guard.constructed < m_size; ++guard.constructed )
+        {
+            size_type const i = guard.constructed;
+
+            if ( has_value( i ) )
+                ::new( static_cast<void *>( guard.values + i ) ) value_type( std::move_if_noexcept( m_values[i] ) );
+        }
+
+        value_type * values = guard.release();
+
+        destroy_values();
+        deallocate( m_values, m_capacity );
+
+        m_values   = values;
+        m_capacity = guard.capacity;
+    }
+
+    void destroy_values() nsstsv_noexcept
+    {
+        if ( std::is_trivially_destructible<value_type>::value )
+            return;
+
+        for ( size_type i = 0; i < m_size; ++i )
+        {
+            if ( has_value( i ) )
+                m_values[i].~value_type();
+        }
+    }
+
+    value_type * m_values;
+    std::vector<status_type> m_statuses;
+    std::vector<word_type> m_engaged;
+    size_type m_size;
+    size_type m_capacity;
+};
+
+template< typename S, typename V >
+constexpr typename status_value_vector<S, V>::size_type status_value_vector<S, V>::word_bits;
+
+template< typename S, typename V >
+void swap( status_value_vector<S, V> & a, status_value_vector<S, V> & b ) nsstsv_noexcept
+{
+    a.swap( b );
+}
+
+namespace status_value_detail {
+
+// Whether a == b compiles for a and b of type T:
+
+template< typename T, typename = void >
+struct is_equality_comparable : std::false_type {};
+
+template< typename T >
+struct is_equality_comparable< T, decltype( void( bool( std::declval<T const &>() == std::declval<T const &>() ) ) ) > : std::true_type {};
+
+} // namespace status_value_detail
+
+// Sequence of results of which most succeed, with statuses for failures only:
+//
+// Successful elements share the success status and their values are stored
+// densely, in order; the index and status of each failure are kept in a side
+// array, sorted by index. A bitmap of failed elements with a count of failures
+// per 64 elements maps an index to its value or failure in O(1). An engaged
+// element with another status than the success status keeps it in a second
+// side array, found by binary search. If S is not equality comparable, such as
+// payload_status, push_back() keeps the status of every engaged element.
+
+template< typename S, typename V >
+class sparse_status_vector
+{
+public:
+    typedef S status_type;
+    typedef V value_type;
+    typedef std::size_t size_type;
+    typedef std::uint64_t word_type;
+
+    struct failure
+    {
+        size_type index;
+        status_type status;
+    };
+
+    explicit sparse_status_vector( status_type success = status_type() )
+    : m_success( std::move( success ) )
+    , m_size( 0 )
+    {}
+
+    // capacity:
+
+    size_type size() const nsstsv_noexcept
+    {
+        return m_size;
+    }
+
+    bool empty() const nsstsv_noexcept
+    {
+        return m_size == 0;
+    }
+
+    // reserve room for capacity elements, of which up to failures fail:
+
+    void reserve( size_type capacity, size_type failures = 0 )
+    {
+        m_values.reserve( capacity );
+        m_failed.reserve( word_count( capacity ) );
+        m_failed_before.reserve( word_count( capacity ) );
+        m_failures.reserve( failures );
+    }
+
+    // bytes allocated by the container, excluding those owned by statuses and values:
+
+    size_type allocated_bytes() const nsstsv_noexcept
+    {
+        return m_values.capacity() * sizeof(value_type)
+            + m_failed.capacity() * sizeof(word_type)
+            + m_failed_before.capacity() * sizeof(size_type)
+            + m_failures.capacity() * sizeof(failure)
+            + m_engaged_statuses.capacity() * sizeof(failure);
+    }
+
+    // modifiers; emplace_value() appends an element with the success status,
+    // push_back() keeps the status of an engaged element if it differs:
+
+    void push_back( status_value<S, V> const & sv )
+    {
+        if ( sv.has_value() )
+        {
+            emplace_value( sv.value() );
+            keep_engaged_status( sv.status() );
+        }
+        else
+        {
+            push_failure( sv.status() );
+        }
+    }
+
+    void push_back( status_value<S, V> && sv )
+    {
+        if ( sv.has_value() )
+        {
+            emplace_value( std::move( sv ).value() );
+            keep_engaged_status( std::move( sv ).status() );
+        }
+        else
+        {
+            push_failure( std::move( sv ).status() );
+        }
+    }
+
+    template< typename... Args >
+    value_type & emplace_value( Args&&... args )
+    {
+        reserve_word();
+        m_values.emplace_back( std::forward<Args>( args )... );
+        ++m_size;
+
+        return m_values.back();
+    }
+
+    void push_failure( status_type s )
+    {
+        reserve_word();
+        m_failures.push_back( failure{ m_size, std::move( s ) } );
+        m_failed.back() |= bit( m_size );
+        ++m_size;
+    }
+
+    void clear() nsstsv_noexcept
+    {
+        m_values.clear();
+        m_failures.clear();
+        m_engaged_statuses.clear();
+        m_failed.clear();
+        m_failed_before.clear();
+        m_size = 0;
+    }
+
+    // element access:
+
+    bool has_value( size_type pos ) const nsstsv_noexcept
+    {
+        return ( m_failed[ pos / 64 ] & bit( pos ) ) == 0;
+    }
+
+    status_type const & status( size_type pos ) const nsstsv_noexcept
+    {
+        return has_value( pos ) ? engaged_status( pos ) : m_failures[ failures_before( pos ) ].status;
+    }
+
+    value_type const & value( size_type pos ) const
+    {
+        if ( ! has_value( pos ) )
+            report_bad_status_value_access( status( pos ) );
+
+        return m_values[ pos - failures_before( pos ) ];
+    }
+
+    value_type & value( size_type pos )
+    {
+        if ( ! has_value( pos ) )
+            report_bad_status_value_access( m_failures[ failures_before( pos ) ].status );
+
+        return m_values[ pos - failures_before( pos ) ];
+    }
+
+    // copy of the element:
+
+    status_value<S, V> operator[]( size_type pos ) const
+    {
+        return has_value( pos ) ? status_value<S, V>( engaged_status( pos ), value( pos ) ) : status_value<S, V>( status( pos ) );
+    }
+
+    // counts, in O(1):
+
+    size_type count_engaged() const nsstsv_noexcept
+    {
+        return m_values.size();
+    }
+
+    size_type count_failed() const nsstsv_noexcept
+    {
+        return m_failures.size();
+    }
+
+    // the values of the engaged elements, in order, and the failures, by index:
+
+    std::vector<value_type> const & values() const nsstsv_noexcept
+    {
+        return m_values;
+    }
+
+    std::vector<failure> const & failures() const nsstsv_noexcept
+    {
+        return m_failures;
+    }
+
+    // engaged elements with another status than the success status, by index:
+
+    std::vector<failure> const & engaged_statuses() const nsstsv_noexcept
+    {
+        return m_engaged_statuses;
+    }
+
+    status_type const & success_status() const nsstsv_noexcept
+    {
+        return m_success;
+    }
+
+    word_type const * failed_words() const nsstsv_noexcept
+    {
+        return m_failed.data();
+    }
+
+    static constexpr size_type word_count( size_type n ) nsstsv_noexcept
+    {
+        return ( n + 63 ) / 64;
+    }
+
+private:
+    static constexpr word_type bit( size_type pos ) nsstsv_noexcept
+    {
+        return word_type( 1 ) << ( pos % 64 );
+    }
+
+    // number of failures before pos:
+
+    size_type failures_before( size_type pos ) const nsstsv_noexcept
+    {
+        return m_failed_before[ pos / 64 ]
+            + static_cast<size_type>( status_value_detail::popcount( m_failed[ pos / 64 ] & ( bit( pos ) - 1 ) ) );
+    }
+
+    status_type const & engaged_status( size_type pos ) const nsstsv_noexcept
+    {
+        if ( m_engaged_statuses.empty() )
+            return m_success;
+
+        auto const it = std::lower_bound( m_engaged_statuses.begin(), m_engaged_statuses.end(), pos
+            , []( failure const & f, size_type i ) { return f.index < i; } );
+
+        return it != m_engaged_statuses.end() && it->index == pos ? it->status : m_success;
+    }
+
+    // Remove the element just appended unless released:
+
+    struct value_guard
+    {
+        sparse_status_vector * vec;
+
+        ~value_guard()
+        {
+            if ( vec )
+            {
+                vec->m_values.pop_back();
+                --vec->m_size;
+            }
+        }
+    };
+
+    // keep the status of the element just appended if it is not the success
+    // status; remove the element if that fails:
+
+    template< typename T >
+    void keep_engaged_status( T && s )
+    {
+        if ( is_success( s, status_value_detail::is_equality_comparable<S>() ) )
+            return;
+
+        value_guard guard = { this };
+        m_engaged_statuses.push_back( failure{ m_size - 1, std::forward<T>( s ) } );
+        guard.vec = nullptr;
+    }
+
+    // whether s equals the success status; not known without operator==:
+
+    bool is_success( status_type const & s, std::true_type ) const
+    {
+        return s == m_success;
+    }
+
+    bool is_success( status_type const &, std::false_type ) const nsstsv_noexcept
+    {
+        return false;
+    }
+
+    // add the word for the next element, if needed:
+
+    void reserve_word()
+    {
+        if ( m_failed.size() < word_count( m_size + 1 ) )
+        {
+            m_failed_before.reserve( m_failed_before.size() + 1 );
+            m_failed.push_back( 0 );
+            m_failed_before.push_back( m_failures.size() );
+        }
+    }
+
+    status_type m_success;
+    std::vector<value_type> m_values;
+    std::vector<failure> m_failures;
+    std::vector<failure> m_engaged_statuses;
+    std::vector<word_type> m_failed;
+    std::vector<size_type> m_failed_before;
+    size_type m_size;
+};
+
+// Instruction sets the batch kernels can select at run time:
+
+enum class simd_isa
+{
+    scalar,
+    avx2,
+    avx512
+};
+
+namespace status_value_detail {
+
+// Number of trailing zero bits, x shall be non-zero:
+
+inline int countr_zero( std::uint64_t x ) nsstsv_noexcept
+{
+#if nsstsv_HAVE_STD_POPCOUNT
+    return std::countr_zero( x );
+#elif defined( __GNUC__ ) || defined( __clang__ )
+    return __builtin_ctzll( x );
+#else
+    return popcount( ( x & ( 0 - x ) ) - 1 );
+#endif
+}
+
+inline simd_isa detect_simd_isa() nsstsv_noexcept
+{
+#if nsstsv_HAVE_X86_SIMD_DISPATCH
+    __builtin_cpu_init();
+
+    return __builtin_cpu_supports( "avx512f" ) ? simd_isa::avx512
+         : __builtin_cpu_supports( "avx2"    ) ? simd_isa::avx2 : simd_isa::scalar;
+#else
+    return simd_isa::scalar;
+#endif
+}
+
+// Copy the values at the bits set in words, scalar:
+
+template< typename V >
+std::size_t compact_scalar( V const * values, std::uint64_t const * words, std::size_t word_count, V * out, std::size_t n ) nsstsv_noexcept
+{
+    for ( std::size_t wi = 0; wi < word_count; ++wi )
+    {
+        std::uint64_t w = words[ wi ];
+        V const * src = values + 64 * wi;
+
+        if ( w == ~std::uint64_t( 0 ) )
+        {
+            std::memcpy( static_cast<void *>( out + n ), src, 64 * sizeof(V) );
+            n += 64;
+            continue;
+        }
+
+        for ( ; w != 0; w &= w - 1 )
+        {
+            out[ n++ ] = src[ countr_zero( w ) ];
+        }
+    }
+    return n;
+}
+
+#if nsstsv_HAVE_X86_SIMD_DISPATCH
+
+// Indices of the set bits of an 8-bit mask, one per byte, for a permutation of 32-bit lanes:
+
+struct compress_table
+{
+    std::uint64_t indices[256];
+
+    compress_table() nsstsv_noexcept
+    {
+        for ( unsigned mask = 0; mask < 256; ++mask )
+        {
+            std::uint64_t entry = 0;
+            unsigned pos = 0;
+
+            for ( unsigned lane = 0; lane < 8; ++lane )
+            {
+                if ( mask & ( 1u << lane ) )
+                    entry |= std::uint64_t( lane ) << ( 8 * pos++ );
+            }
+            indices[ mask ] = entry;
+        }
+    }
+};
+
+inline std::uint64_t const * compress_indices() nsstsv_noexcept
+{
+    static compress_table const table;
+    return table.indices;
+}
+
+// Permute the selected lanes to the front and store all eight 32-bit lanes;
+// words near the end of the input or output are copied scalar, so that
+// neither the loads nor the stores pass the end:
+
+template< typename V >
+__attribute__(( target( "avx2" ) ))
+std::size_t compact_avx2( V const * values, std::uint64_t const * words, std::size_t size, V * out, std::size_t total ) nsstsv_noexcept
+{
+    // per 32-bit lanes: 4-byte values use a lane each, 8-byte values two:
+
+    std::size_t const lanes_per_value = sizeof(V) / 4;
+    std::size_t const values_per_chunk = 8 / lanes_per_value;
+    std::uint64_t const chunk_mask = ( std::uint64_t( 1 ) << values_per_chunk ) - 1;
+
+    std::uint64_t const * table = compress_indices();
+    std::size_t const word_count = ( size + 63 ) / 64;
+    std::size_t n = 0;
+
+    for ( std::size_t wi = 0; wi < word_count; ++wi )
+    {
+        std::uint64_t w = words[ wi ];
+        V const * src = values + 64 * wi;
+
+        if ( 64 * ( wi + 1 ) > size || n + 64 > total )
+        {
+            n = compact_scalar( src, &w, 1, out, n );
+            continue;
+        }
+
+        for ( std::size_t k = 0; k < 64; k += values_per_chunk, w >>= values_per_chunk )
+        {
+            unsigned mask = static_cast<unsigned>( w & chunk_mask );
+
+            if ( lanes_per_value == 2 )
+            {
+                // spread each bit over the two lanes of a value:
+                mask = ( mask & 1u ) * 3u | ( mask & 2u ) * 6u | ( mask & 4u ) * 12u | ( mask & 8u ) * 24u;
+            }
+
+            __m256i const v   = _mm256_loadu_si256( reinterpret_cast<__m256i const *>( src + k ) );
+            __m256i const idx = _mm256_cvtepu8_epi32( _mm_loadl_epi64( reinterpret_cast<__m128i const *>( table + mask ) ) );
+
+            _mm256_storeu_si256( reinterpret_cast<__m256i *>( out + n ), _mm256_permutevar8x32_epi32( v, idx ) );
+            n += static_cast<std::size_t>( popcount( mask ) ) / lanes_per_value;
+        }
+    }
+    return n;
+}
+
+// Masked loads and compressing stores touch only the selected values:
+
+template< typename V >
+__attribute__(( target( "avx512f" ) ))
+std::size_t compact_avx512( V const * values, std::uint64_t const * words, std::size_t size, V * out ) nsstsv_noexcept
+{
+    std::size_t const word_count = ( size + 63 ) / 64;
+    std::size_t n = 0;
+
+    for ( std::size_t wi = 0; wi < word_count; ++wi )
+    {
+        std::uint64_t const w = words[ wi ];
+        V const * src = values + 64 * wi;
+
+        if ( sizeof(V) == 4 )
+        {
+            for ( std::size_t k = 0; k < 64; k += 16 )
+            {
+                __mmask16 const mask = static_cast<__mmask16>( w >> k );
+                __m512i const v = _mm512_maskz_loadu_epi32( mask, src + k );
+
+                _mm512_mask_compressstoreu_epi32( out + n, mask, v );
+                n += static_cast<std::size_t>( popcount( mask ) );
+            }
+        }
+        else
+        {
+            for ( std::size_t k = 0; k < 64; k += 8 )
+            {
+                __mmask8 const mask = static_cast<__mmask8>( w >> k );
+                __m512i const v = _mm512_maskz_loadu_epi64( mask, src + k );
+
+                _mm512_mask_compressstoreu_epi64( out + n, mask, v );
+                n += static_cast<std::size_t>( popcount( mask ) );
+            }
+        }
+    }
+    return n;
+}
+
+// SIMD compaction of values of 4 or 8 bytes, scalar for other values:
+
+template< typename V >
+std::size_t compact_simd( std::true_type, simd_isa isa, V const * values, std::uint64_t const * words, std::size_t size, std::size_t total, V * out ) nsstsv_noexcept
+{
+    if ( isa == simd_isa::avx512 )
+        return compact_avx512( values, words, size, out );
+
+    if ( isa == simd_isa::avx2 )
+        return compact_avx2( values, words, size, out, total );
+
+    return compact_scalar( values, words, ( size + 63 ) / 64, out, 0 );
+}
+
+#endif // nsstsv_HAVE_X86_SIMD_DISPATCH
+
+template< typename V >
+std::size_t compact_simd( std::false_type, simd_isa, V const * values, std::uint64_t const * words, std::size_t size, std::size_t, V * out ) nsstsv_noexcept
+{
+    return compact_scalar( values, words, ( size + 63 ) / 64, out, 0 );
+}
+
+} // namespace status_value_detail
+
+// Instruction set the batch kernels select, detected once:
+
+inline simd_isa detected_simd_isa() nsstsv_noexcept
+{
+    static simd_isa const isa = status_value_detail::detect_simd_isa();
+    return isa;
+}
+
+// Copy the values of the engaged elements of batch to out, in order, using
+// isa if the processor supports it, a lesser instruction set otherwise:
+//
+// out shall have room for batch.count_engaged() values. Returns the number
+// of values copied. Values of 4 or 8 bytes are compacted with SIMD.
+
+template< typename S, typename V >
+std::size_t compact_values( status_value_vector<S, V> const & batch, V * out, simd_isa isa ) nsstsv_noexcept
+{
+    static_assert( std::is_trivially_copyable<V>::value, "compact_values: value shall be trivially copyable" );
+
+    if ( isa > detected_simd_isa() )
+        isa = detected_simd_isa();
+
+    return status_value_detail::compact_simd( std::integral_constant< bool, nsstsv_HAVE_X86_SIMD_DISPATCH && ( sizeof(V) == 4 || sizeof(V) == 8 ) >(),
+        isa, batch.values(), batch.engaged_words(), batch.size(), isa == simd_isa::avx2 ? batch.count_engaged() : 0, out );
+}
+
+template< typename S, typename V >
+std::size_t compact_values( status_value_vector<S, V> const & batch, V * out ) nsstsv_noexcept
+{
+    return compact_values( batch, out, detected_simd_isa() );
+}
+
+namespace status_value_detail {
+
+// Size of the stack buffer that values of 4 or 8 bytes are compacted into:
+
+enum : std::size_t { compact_scratch_bytes = 8192 };
+
+// Pass the values of the engaged elements of the words [wi, wj), none with all
+// elements engaged, to append( first, count ): compacted with SIMD via scratch,
+// leaving a word of slack for the AVX2 stores, or run by run of consecutive
+// engaged elements:
+
+template< typename V, typename Append >
+void append_partial_words( std::true_type, simd_isa isa, V const * slots, std::uint64_t const * words, std::size_t wi, std::size_t wj, std::size_t size, Append & append )
+{
+    enum : std::size_t
+    {
+        capacity = compact_scratch_bytes / sizeof(V),
+        scratch_words = capacity / 64 - 1
+    };
+
+    alignas( V ) unsigned char scratch[ compact_scratch_bytes ];
+    V * const buffer = reinterpret_cast<V *>( scratch );
+
+    for ( ; wi < wj; wi += scratch_words )
+    {
+        std::size_t const wk = wj - wi < scratch_words ? wj : wi + scratch_words;
+        std::size_t const n = ( size < 64 * wk ? size : 64 * wk ) - 64 * wi;
+
+        append( static_cast<V const *>( buffer ), compact_simd( std::true_type(), isa, slots + 64 * wi, words + wi, n, std::size_t( capacity ), buffer ) );
+    }
+}
+
+template< typename V, typename Append >
+void append_partial_words( std::false_type, simd_isa, V const * slots, std::uint64_t const * words, std::size_t wi, std::size_t wj, std::size_t, Append & append )
+{
+    for ( ; wi < wj; ++wi )
+    {
+        for ( std::uint64_t w = words[ wi ]; w != 0; )
+        {
+            int const first = countr_zero( w );
+            std::uint64_t const rest = ~( w >> first );
+            int const last = rest == 0 ? 64 : first + countr_zero( rest );
+
+            append( slots + 64 * wi + first, static_cast<std::size_t>( last - first ) );
+            w = last == 64 ? 0 : w & ( ~std::uint64_t( 0 ) << last );
+        }
+    }
+}
+
+// Pass the values of the engaged elements to append( first, count ) in order
+// and in stretches: those of consecutive words with all elements engaged as
+// is, the others as above:
+
+template< typename V, typename Append >
+void append_engaged_values( simd_isa isa, V const * slots, std::uint64_t const * words, std::size_t size, Append && append )
+{
+    std::size_t const word_count = ( size + 63 ) / 64;
+
+    for ( std::size_t wi = 0; wi < word_count; )
+    {
+        std::size_t wj = wi;
+
+        while ( wj < word_count && words[ wj ] == ~std::uint64_t( 0 ) )
+            ++wj;
+
+        if ( wj > wi )
+        {
+            append( slots + 64 * wi, 64 * ( wj - wi ) );
+            wi = wj;
+            continue;
+        }
+
+        while ( wj < word_count && words[ wj ] != ~std::uint64_t( 0 ) )
+            ++wj;
+
+        append_partial_words( std::integral_constant< bool, nsstsv_HAVE_X86_SIMD_DISPATCH && ( sizeof(V) == 4 || sizeof(V) == 8 ) >()
+            , isa, slots, words, wi, wj, size, append );
+        wi = wj;
+    }
+}
+
+} // namespace status_value_detail
+
+// Append the values of the engaged elements of batch to out:
+//
+// Room is reserved up front and filled by insertion, without value-initializing
+// it first: words with all elements engaged are inserted as is, the values of
+// the other words compacted into a buffer on the stack, or run by run.
+
+template< typename S, typename V, typename Alloc >
+void compact_values( status_value_vector<S, V> const & batch, std::vector<V, Alloc> & out )
+{
+    static_assert( std::is_trivially_copyable<V>::value, "compact_values: value shall be trivially copyable" );
+
+    out.reserve( out.size() + batch.count_engaged() );
+
+    status_value_detail::append_engaged_values( detected_simd_isa(), batch.values(), batch.engaged_words(), batch.size(),
+        [&out]( V const * first, std::size_t count ) { out.insert( out.end(), first, first + count ); } );
+}
+
+namespace status_value_detail {
+
+// Bin of an integral or enumeration code, bins for codes outside [0, bins):
+
+template< typename Code >
+std::size_t status_bin( Code code, std::size_t bins ) nsstsv_noexcept
+{
+    static_assert( std::is_integral<Code>::value || std::is_enum<Code>::value, "status_histogram: status shall be an integral or enumeration type" );
+
+    using underlying = typename std::conditional< std::is_enum<Code>::value, std::underlying_type<Code>, std::common_type<Code> >::type::type;
+    using key_type = typename std::make_unsigned<underlying>::type;
+
+    std::uint64_t const key = static_cast<key_type>( static_cast<underlying>( code ) );
+
+    return key < bins ? static_cast<std::size_t>( key ) : bins;
+}
+
+} // namespace status_value_detail
+
+// Number of elements per status code, for integral and enumeration statuses:
+//
+// Codes in [0, bins) are counted per code, other codes together.
+
+class status_counts
+{
+public:
+    typedef std::size_t size_type;
+
+    explicit status_counts( size_type bins )
+    : m_counts( bins )
+    , m_other( 0 )
+    {}
+
+    size_type bins() const nsstsv_noexcept
+    {
+        return m_counts.size();
+    }
+
+    // number of elements with status code:
+
+    template< typename Code >
+    size_type count( Code code ) const nsstsv_noexcept
+    {
+        size_type const bin = bin_of( code );
+        return bin < bins() ? m_counts[ bin ] : 0;
+    }
+
+    // number of elements with a code outside [0, bins):
+
+    size_type other() const nsstsv_noexcept
+    {
+        return m_other;
+    }
+
+    size_type total() const nsstsv_noexcept
+    {
+        size_type sum = m_other;
+
+        for ( size_type c : m_counts )
+        {
+            sum += c;
+        }
+        return sum;
+    }
+
+    std::vector<size_type> const & counts() const nsstsv_noexcept
+    {
+        return m_counts;
+    }
+
+    // add n to the count of code:
+
+    template< typename Code >
+    void add( Code code, size_type n = 1 ) nsstsv_noexcept
+    {
+        add_to_bin( bin_of( code ), n );
+    }
+
+    // add n to the count of bin, bins() for other codes:
+
+    void add_to_bin( size_type bin, size_type n ) nsstsv_noexcept
+    {
+        ( bin < bins() ? m_counts[ bin ] : m_other ) += n;
+    }
+
+    // merge the counts of a histogram with the same number of bins:
+
+    status_counts & operator+=( status_counts const & other ) nsstsv_noexcept
+    {
+        for ( size_type i = 0; i < bins() && i < other.bins(); ++i )
+        {
+            m_counts[i] += other.m_counts[i];
+        }
+        m_other += other.m_other;
+        return *this;
+    }
+
+    // bin of code, bins() for codes outside [0, bins):
+
+    template< typename Code >
+    size_type bin_of( Code code ) const nsstsv_noexcept
+    {
+        return status_value_detail::status_bin( code, bins() );
+    }
+
+private:
+    std::vector<size_type> m_counts;
+    size_type m_other;
+};
+
+namespace status_value_detail {
+
+// Four partial histograms, so that runs of equal codes do not wait on the
+// previous increment of the same counter:
+
+class partial_histograms
+{
+public:
+    explicit partial_histograms( status_counts const & result )
+    : m_bins( result.bins() )
+    , m_stride( result.bins() + 1 )
+    , m_counts( 4 * m_stride )
+    {}
+
+    template< typename Code >
+    void add( std::size_t lane, Code code ) nsstsv_noexcept
+    {
+        ++m_counts[ lane * m_stride + status_bin( code, m_bins ) ];
+    }
+
+    // count the codes of n elements, get( i ) yields the code of element i:
+
+    template< typename Get >
+    void add_all( std::size_t n, Get get ) nsstsv_noexcept
+    {
+        std::size_t i = 0;
+
+        for ( ; i + 4 <= n; i += 4 )
+        {
+            add( 0, get( i     ) );
+            add( 1, get( i + 1 ) );
+            add( 2, get( i + 2 ) );
+            add( 3, get( i + 3 ) );
+        }
+        for ( ; i < n; ++i )
+        {
+            add( 0, get( i ) );
+        }
+    }
+
+    void merge_into( status_counts & result ) const nsstsv_noexcept
+    {
+        for ( std::size_t bin = 0; bin < m_stride; ++bin )
+        {
+            result.add_to_bin( bin, m_counts[ bin ] + m_counts[ m_stride + bin ] + m_counts[ 2 * m_stride + bin ] + m_counts[ 3 * m_stride + bin ] );
+        }
+    }
+
+private:
+    std::size_t m_bins;
+    std::size_t m_stride;
+    std::vector<std::size_t> m_counts;
+};
+
+#if nsstsv_HAVE_X86_SIMD_DISPATCH
+
+// Vectorised histogram of 4-byte codes, per chunk that fits in the L1 cache:
+// find the least and greatest code of the chunk and, if they span at most
+// histogram_simd_codes values, count each of them by comparing eight or
+// sixteen elements at once and accumulating the matches per lane. A chunk
+// with codes that span more values is counted scalar.
+
+enum : std::size_t { histogram_simd_chunk = 4096, histogram_simd_codes = 16 };
+
+// Code k after lo, wrapping around past the greatest code:
+
+inline std::int32_t code_after( std::int32_t lo, std::size_t k ) nsstsv_noexcept
+{
+    return static_cast<std::int32_t>( static_cast<std::uint32_t>( lo ) + static_cast<std::uint32_t>( k ) );
+}
+
+// Add the counts of the codes lo up to lo + span to result:
+
+template< typename S >
+void add_code_counts( std::int32_t lo, std::size_t span, std::uint32_t const * counts, status_counts & result )
+{
+    for ( std::size_t k = 0; k < span; ++k )
+    {
+        if ( counts[k] != 0 )
+            result.add( static_cast<S>( code_after( lo, k ) ), counts[k] );
+    }
+}
+
+// Count the codes lo up to lo + sizeof...(K) of n elements, n a multiple of
+// 8 or 16; the expansion over K keeps the keys and counters in registers:
+
+template< std::size_t... K >
+__attribute__(( target( "avx2" ) ))
+void count_codes_avx2( index_sequence<K...>, std::int32_t const * codes, std::size_t n, std::int32_t lo, std::uint32_t * counts ) nsstsv_noexcept
+{
+    typedef int expand[];
+
+    __m256i const key[] = { _mm256_set1_epi32( code_after( lo, K ) )... };
+    __m256i acc[] = { ( (void) K, _mm256_setzero_si256() )... };
+
+    for ( std::size_t i = 0; i < n; i += 8 )
+    {
+        __m256i const v = _mm256_loadu_si256( reinterpret_cast<__m256i const *>( codes + i ) );
+
+        (void) expand{ ( acc[K] = _mm256_sub_epi32( acc[K], _mm256_cmpeq_epi32( v, key[K] ) ), 0 )... };
+    }
+
+    for ( std::size_t k = 0; k < sizeof...(K); ++k )
+    {
+        alignas( 32 ) std::uint32_t lanes[8];
+        _mm256_store_si256( reinterpret_cast<__m256i *>( lanes ), acc[k] );
+
+        for ( int lane = 0; lane < 8; ++lane )
+            counts[k] += lanes[lane];
+    }
+}
+
+template< std::size_t... K >
+__attribute__(( target( "avx512f" ) ))
+void count_codes_avx512( index_sequence<K...>, std::int32_t const * codes, std::size_t n, std::int32_t lo, std::uint32_t * counts ) nsstsv_noexcept
+{
+    typedef int expand[];
+
+    __m512i const one = _mm512_set1_epi32( 1 );
+    __m512i const key[] = { _mm512_set1_epi32( code_after( lo, K ) )... };
+    __m512i acc[] = { ( (void) K, _mm512_setzero_si512() )... };
+
+    for ( std::size_t i = 0; i < n; i += 16 )
+    {
+        __m512i const v = _mm512_loadu_si512( codes + i );
+
+        (void) expand{ ( acc[K] = _mm512_mask_add_epi32( acc[K], _mm512_cmpeq_epi32_mask( v, key[K] ), acc[K], one ), 0 )... };
+    }
+
+    for ( std::size_t k = 0; k < sizeof...(K); ++k )
+    {
+        alignas( 64 ) std::uint32_t lanes[16];
+        _mm512_store_si512( lanes, acc[k] );
+
+        for ( int lane = 0; lane < 16; ++lane )
+            counts[k] += lanes[lane];
+    }
+}
+
+// Least and greatest code of n elements, n a non-zero multiple of 8 or 16:
+
+__attribute__(( target( "avx2" ) ))
+inline void code_range_avx2( std::int32_t const * codes, std::size_t n, std::int32_t & lo, std::int32_t & hi ) nsstsv_noexcept
+{
+    __m256i lo8 = _mm256_loadu_si256( reinterpret_cast<__m256i const *>( codes ) );
+    __m256i hi8 = lo8;
+
+    for ( std::size_t i = 8; i < n; i += 8 )
+    {
+        __m256i const v = _mm256_loadu_si256( reinterpret_cast<__m256i const *>( codes + i ) );
+        lo8 = _mm256_min_epi32( lo8, v );
+        hi8 = _mm256_max_epi32( hi8, v );
+    }
+
+    alignas( 32 ) std::int32_t lows[8];
+    alignas( 32 ) std::int32_t highs[8];
+    _mm256_store_si256( reinterpret_cast<__m256i *>( lows  ), lo8 );
+    _mm256_store_si256( reinterpret_cast<__m256i *>( highs ), hi8 );
+
+    lo = lows[0];
+    hi = highs[0];
+
+    for ( int lane = 1; lane < 8; ++lane )
+    {
+        lo = lows [lane] < lo ? lows [lane] : lo;
+        hi = highs[lane] > hi ? highs[lane] : hi;
+    }
+}
+
+__attribute__(( target( "avx512f" ) ))
+inline void code_range_avx512( std::int32_t const * codes, std::size_t n, std::int32_t & lo, std::int32_t & hi ) nsstsv_noexcept
+{
+    __m512i lo16 = _mm512_loadu_si512( codes );
+    __m512i hi16 = lo16;
+
+    for ( std::size_t i = 16; i < n; i += 16 )
+    {
+        __m512i const v = _mm512_loadu_si512( codes + i );
+        lo16 = _mm512_maskz_min_epi32( 0xffff, lo16, v );
+        hi16 = _mm512_maskz_max_epi32( 0xffff, hi16, v );
+    }
+
+    alignas( 64 ) std::int32_t lows[16];
+    alignas( 64 ) std::int32_t highs[16];
+    _mm512_store_si512( lows , lo16 );
+    _mm512_store_si512( highs, hi16 );
+
+    lo = lows[0];
+    hi = highs[0];
+
+    for ( int lane = 1; lane < 16; ++lane )
+    {
+        lo = lows [lane] < lo ? lows [lane] : lo;
+        hi = highs[lane] > hi ? highs[lane] : hi;
+    }
+}
+
+// Count a chunk with instantiations for 1, 2, 4, 8 and 16 codes; false if
+// the codes span more:
+
+template< typename Isa >
+bool count_chunk( Isa, std::int32_t const * codes, std::size_t n, std::int32_t lo, std::int32_t hi, std::uint32_t * counts ) nsstsv_noexcept
+{
+    std::int64_t const span = std::int64_t( hi ) - lo + 1;
+
+    if      ( span <=  1 ) Isa::template count<  1 >( codes, n, lo, counts );
+    else if ( span <=  2 ) Isa::template count<  2 >( codes, n, lo, counts );
+    else if ( span <=  4 ) Isa::template count<  4 >( codes, n, lo, counts );
+    else if ( span <=  8 ) Isa::template count<  8 >( codes, n, lo, counts );
+    else if ( span <= 16 ) Isa::template count< 16 >( codes, n, lo, counts );
+    else return false;
+
+    return true;
+}
+
+struct avx2_kernels
+{
+    static constexpr std::size_t lanes = 8;
+
+    template< std::size_t Codes >
+    static void count( std::int32_t const * codes, std::size_t n, std::int32_t lo, std::uint32_t * counts ) nsstsv_noexcept
+    {
+        count_codes_avx2( make_index_sequence<Codes>(), codes, n, lo, counts );
+    }
+
+    static void range( std::int32_t const * codes, std::size_t n, std::int32_t & lo, std::int32_t & hi ) nsstsv_noexcept
+    {
+        code_range_avx2( codes, n, lo, hi );
+    }
+};
+
+struct avx512_kernels
+{
+    static constexpr std::size_t lanes = 16;
+
+    template< std::size_t Codes >
+    static void count( std::int32_t const * codes, std::size_t n, std::int32_t lo, std::uint32_t * counts ) nsstsv_noexcept
+    {
+        count_codes_avx512( make_index_sequence<Codes>(), codes, n, lo, counts );
+    }
+
+    static void range( std::int32_t const * codes, std::size_t n, std::int32_t & lo, std::int32_t & hi ) nsstsv_noexcept
+    {
+        code_range_avx512( codes, n, lo, hi );
+    }
+};
+
+template< typename Isa, typename S >
+void histogram_chunks( Isa isa, S const * statuses, std::size_t n, status_counts & result, partial_histograms & partial )
+{
+    std::int32_t const * codes = reinterpret_cast<std::int32_t const *>( statuses );
+    std::size_t i = 0;
+
+    while ( n - i >= Isa::lanes )
+    {
+        std::size_t const len = ( n - i < histogram_simd_chunk ? n - i : histogram_simd_chunk ) / Isa::lanes * Isa::lanes;
+
+        std::int32_t lo = 0;
+        std::int32_t hi = 0;
+        std::uint32_t counts[ histogram_simd_codes ] = {};
+
+        Isa::range( codes + i, len, lo, hi );
+
+        if ( count_chunk( isa, codes + i, len, lo, hi, counts ) )
+            add_code_counts<S>( lo, histogram_simd_codes, counts, result );
+        else
+            partial.add_all( len, [&]( std::size_t k ) { return statuses[ i + k ]; } );
+
+        i += len;
+    }
+    partial.add_all( n - i, [&]( std::size_t k ) { return statuses[ i + k ]; } );
+}
+
+// SIMD histogram of 4-byte codes:
+
+template< typename S >
+void histogram_simd( std::true_type, simd_isa isa, S const * statuses, std::size_t n, status_counts & result, partial_histograms & partial )
+{
+    if ( isa == simd_isa::avx512 )
+        histogram_chunks( avx512_kernels(), statuses, n, result, partial );
+    else if ( isa == simd_isa::avx2 )
+        histogram_chunks( avx2_kernels(), statuses, n, result, partial );
+    else
+        partial.add_all( n, [&]( std::size_t i ) { return statuses[i]; } );
+}
+
+#endif // nsstsv_HAVE_X86_SIMD_DISPATCH
+
+template< typename S >
+void histogram_simd( std::false_type, simd_isa, S const * statuses, std::size_t n, status_counts &, partial_histograms & partial )
+{
+    partial.add_all( n, [&]( std::size_t i ) { return statuses[i]; } );
+}
+
+} // namespace status_value_detail
+
+// Histogram of the status codes of a batch in [0, bins), other codes together,
+// using isa if the processor supports it, a lesser instruction set otherwise:
+
+template< typename S, typename V >
+status_counts status_histogram( status_value_vector<S, V> const & batch, std::size_t bins, simd_isa isa )
+{
+    status_counts result( bins );
+
+    if ( batch.empty() )
+        return result;
+
+    if ( isa > detected_simd_isa() )
+        isa = detected_simd_isa();
+
+    status_value_detail::partial_histograms partial( result );
+
+    status_value_detail::histogram_simd(
+        std::integral_constant< bool, nsstsv_HAVE_X86_SIMD_DISPATCH && sizeof(S) == 4 >(), isa, batch.statuses(), batch.size(), result, partial );
+
+    partial.merge_into( result );
+
+    return result;
+}
+
+template< typename S, typename V >
+status_counts status_histogram( status_value_vector<S, V> const & batch, std::size_t bins = 256 )
+{
+    return status_histogram( batch, bins, detected_simd_isa() );
+}
+
+template< typename S, typename V, typename Alloc >
+status_counts status_histogram( std::vector< status_value<S, V>, Alloc > const & batch, std::size_t bins = 256 )
+{
+    status_counts result( bins );
+    status_value_detail::partial_histograms partial( result );
+
+    partial.add_all( batch.size(), [&]( std::size_t i ) { return batch[i].status(); } );
+    partial.merge_into( result );
+
+    return result;
+}
+
+// Successes are counted at once, failures individually:
+
+template< typename S, typename V >
+status_counts status_histogram( sparse_status_vector<S, V> const & batch, std::size_t bins = 256 )
+{
+    status_counts result( bins );
+
+    result.add( batch.success_status(), batch.count_engaged() - batch.engaged_statuses().size() );
+
+    for ( auto const & f : batch.engaged_statuses() )
+    {
+        result.add( f.status );
+    }
+
+    for ( auto const & f : batch.failures() )
+    {
+        result.add( f.status );
+    }
+    return result;
+}
+
+// Indices of the elements of a batch grouped by status code, in order of
+// code and stable within a group:
+//
+// Codes in [0, bins) each have a group, other codes share the last group.
+
+class status_groups
+{
+public:
+    typedef std::size_t size_type;
+
+    // Indices of a group:
+
+    class range
+    {
+    public:
+        range( size_type const * first, size_type const * last ) nsstsv_noexcept
+        : m_first( first ), m_last( last ) {}
+
+        size_type const * begin() const nsstsv_noexcept { return m_first; }
+        size_type const * end()   const nsstsv_noexcept { return m_last;  }
+        size_type size()          const nsstsv_noexcept { return static_cast<size_type>( m_last - m_first ); }
+        bool empty()              const nsstsv_noexcept { return m_first == m_last; }
+
+    private:
+        size_type const * m_first;
+        size_type const * m_last;
+    };
+
+    // offsets holds bins + 2 ascending positions in indices, delimiting the groups:
+
+    status_groups( std::vector<size_type> offsets, std::vector<size_type> indices ) nsstsv_noexcept
+    : m_offsets( std::move( offsets ) )
+    , m_indices( std::move( indices ) )
+    {}
+
+    size_type bins() const nsstsv_noexcept
+    {
+        return m_offsets.size() - 2;
+    }
+
+    // indices of the elements with status code:
+
+    template< typename Code >
+    range group( Code code ) const nsstsv_noexcept
+    {
+        size_type const bin = status_value_detail::status_bin( code, bins() );
+        return bin < bins() ? group_of_bin( bin ) : range( nullptr, nullptr );
+    }
+
+    // indices of the elements with a code outside [0, bins):
+
+    range other() const nsstsv_noexcept
+    {
+        return group_of_bin( bins() );
+    }
+
+    range group_of_bin( size_type bin ) const nsstsv_noexcept
+    {
+        return range( m_indices.data() + m_offsets[ bin ], m_indices.data() + m_offsets[ bin + 1 ] );
+    }
+
+    std::vector<size_type> const & offsets() const nsstsv_noexcept
+    {
+        return m_offsets;
+    }
+
+    std::vector<size_type> const & indices() const nsstsv_noexcept
+    {
+        return m_indices;
+    }
+
+private:
+    std::vector<size_type> m_offsets;
+    std::vector<size_type> m_indices;
+};
+
+namespace status_value_detail {
+
+// Counting sort of the indices by the bin of their status, status( i ) yields
+// the code of element i:
+
+template< typename Status >
+status_groups make_status_groups( status_counts const & counts, std::size_t n, Status status )
+{
+    std::size_t const bins = counts.bins();
+    std::vector<std::size_t> offsets( bins + 2 );
+
+    for ( std::size_t bin = 0; bin < bins; ++bin )
+    {
+        offsets[ bin + 1 ] = offsets[ bin ] + counts.counts()[ bin ];
+    }
+    offsets[ bins + 1 ] = n;
+
+    std::vector<std::size_t> cursors( offsets.begin(), offsets.end() - 1 );
+    std::vector<std::size_t> indices( n );
+
+    for ( std::size_t i = 0; i < n; ++i )
+    {
+        indices[ cursors[ status_bin( status( i ), bins ) ]++ ] = i;
+    }
+    return status_groups( std::move( offsets ), std::move( indices ) );
+}
+
+} // namespace status_value_detail
+
+// Group the elements of a batch by status code in O(n):
+
+template< typename S, typename V >
+status_groups group_by_status( status_value_vector<S, V> const & batch, std::size_t bins = 256 )
+{
+    return status_value_detail::make_status_groups( status_histogram( batch, bins ), batch.size(),
+        [&]( std::size_t i ) { return batch.statuses()[i]; } );
+}
+
+template< typename S, typename V, typename Alloc >
+status_groups group_by_status( std::vector< status_value<S, V>, Alloc > const & batch, std::size_t bins = 256 )
+{
+    return status_value_detail::make_status_groups( status_histogram( batch, bins ), batch.size(),
+        [&]( std::size_t i ) { return batch[i].status(); } );
+}
+
+// Reorder a batch by status code in O(n), stable, moving each value once;
+// the indices of the groups are the positions the elements had:
+
+namespace status_value_detail {
+
+// Move the element at pos of batch to the end of out, status and value:
+
+struct batch_partition
+{
+    template< typename S, typename V >
+    static void move_element( status_value_vector<S, V> & batch, std::size_t pos, status_value_vector<S, V> & out )
+    {
+        if ( batch.has_value( pos ) )
+            out.emplace_back( std::move( batch.m_statuses[ pos ] ), std::move( batch.value( pos ) ) );
+        else
+            out.emplace_back( std::move( batch.m_statuses[ pos ] ) );
+    }
+};
+
+} // namespace status_value_detail
+
+template< typename S, typename V >
+status_groups partition_by_status( status_value_vector<S, V> & batch, std::size_t bins = 256 )
+{
+    status_groups groups = group_by_status( batch, bins );
+    status_value_vector<S, V> partitioned;
+
+    partitioned.reserve( batch.size() );
+
+    for ( std::size_t i : groups.indices() )
+        status_value_detail::batch_partition::move_element( batch, i, partitioned );
+
+    batch.swap( partitioned );
+    return groups;
+}
+
+namespace status_value_detail {
+
+// Result of stages applied in turn to arg, each to the value of the previous:
+
+template< typename Arg, typename... Stages >
+struct pipeline_result;
+
+template< typename Arg, typename Stage >
+struct pipeline_result< Arg, Stage >
+{
+    typedef typename std::decay< invoke_result_t<Stage &, Arg> >::type type;
+};
+
+template< typename Arg, typename Stage, typename Next, typename... Stages >
+struct pipeline_result< Arg, Stage, Next, Stages... >
+{
+    typedef typename std::decay< invoke_result_t<Stage &, Arg> >::type stage_type;
+    typedef typename pipeline_result< typename stage_type::value_type &&, Next, Stages... >::type type;
+};
+
+// Apply the stages in turn, stopping at the first failure:
+
+template< typename Result, typename Arg, typename Stage >
+Result run_stages( Arg && arg, Stage & stage )
+{
+    return status_value_detail::invoke( stage, std::forward<Arg>( arg ) );
+}
+
+template< typename Result, typename Arg, typename Stage, typename Next, typename... Stages >
+Result run_stages( Arg && arg, Stage & stage, Next & next, Stages &... stages )
+{
+    auto sv = status_value_detail::invoke( stage, std::forward<Arg>( arg ) );
+
+    if ( ! sv )
+        return Result( std::move( sv ).status() );
+
+    return run_stages<Result>( std::move( sv ).value(), next, stages... );
+}
+
+} // namespace status_value_detail
+
+// Stages that each take the value of the previous stage and return a
+// status_value, fused to run in a single pass per element:
+//
+// Applying the pipeline to an element runs the stages in turn and returns the
+// result of the last, or the status of the first stage that fails, without
+// running the rest. Values are moved from stage to stage.
+
+template< typename... Stages >
+class pipeline
+{
+public:
+    template< typename Arg >
+    using result_type = typename status_value_detail::pipeline_result<Arg, Stages...>::type;
+
+    template< typename Arg >
+    using const_result_type = typename status_value_detail::pipeline_result<Arg, Stages const...>::type;
+
+    explicit pipeline( Stages... stages )
+    : m_stages( std::move( stages )... ) {}
+
+    template< typename Arg >
+    result_type<Arg> operator()( Arg && arg )
+    {
+        return apply( std::forward<Arg>( arg ), status_value_detail::make_index_sequence<sizeof...(Stages)>() );
+    }
+
+    template< typename Arg >
+    const_result_type<Arg> operator()( Arg && arg ) const
+    {
+        return apply( std::forward<Arg>( arg ), status_value_detail::make_index_sequence<sizeof...(Stages)>() );
+    }
+
+    // append the result for each element of inputs to out, via push_back():
+
+    template< typename Range, typename Out >
+    void run( Range && inputs, Out & out )
+    {
+        for ( auto && input : inputs )
+        {
+            out.push_back( (*this)( std::forward<decltype( input )>( input ) ) );
+        }
+    }
+
+    template< typename Range, typename Out >
+    void run( Range && inputs, Out & out ) const
+    {
+        for ( auto && input : inputs )
+        {
+            out.push_back( (*this)( std::forward<decltype( input )>( input ) ) );
+        }
+    }
+
+    // pipeline with stage appended:
+
+    template< typename Stage >
+    pipeline< Stages..., typename std::decay<Stage>::type > then( Stage && stage ) const &
+    {
+        return then( std::forward<Stage>( stage ), m_stages, status_value_detail::make_index_sequence<sizeof...(Stages)>() );
+    }
+
+    template< typename Stage >
+    pipeline< Stages..., typename std::decay<Stage>::type > then( Stage && stage ) &&
+    {
+        return then( std::forward<Stage>( stage ), std::move( m_stages ), status_value_detail::make_index_sequence<sizeof...(Stages)>() );
+    }
+
+private:
+    template< typename... Others >
+    friend class pipeline;
+
+    template< typename Arg, std::size_t... I >
+    result_type<Arg> apply( Arg && arg, status_value_detail::index_sequence<I...> )
+    {
+        return status_value_detail::run_stages< result_type<Arg> >( std::forward<Arg>( arg ), std::get<I>( m_stages )... );
+    }
+
+    template< typename Arg, std::size_t... I >
+    const_result_type<Arg> apply( Arg && arg, status_value_detail::index_sequence<I...> ) const
+    {
+        return status_value_detail::run_stages< const_result_type<Arg> >( std::forward<Arg>( arg ), std::get<I>( m_stages )... );
+    }
+
+    template< typename Stage, typename Tuple, std::size_t... I >
+    static pipeline< Stages..., typename std::decay<Stage>::type > then( Stage && stage, Tuple && stages, status_value_detail::index_sequence<I...> )
+    {
+        return pipeline< Stages..., typename std::decay<Stage>::type >( std::get<I>( std::forward<Tuple>( stages ) )..., std::forward<Stage>( stage ) );
+    }
+
+    std::tuple<Stages...> m_stages;
+};
+
+template< typename... Stages >
+pipeline< typename std::decay<Stages>::type... > make_pipeline( Stages&&... stages )
+{
+    return pipeline< typename std::decay<Stages>::type... >( std::forward<Stages>( stages )... );
+}
+
+template< typename... Stages, typename Stage >
+pipeline< Stages..., typename std::decay<Stage>::type > operator|( pipeline<Stages...> const & p, Stage && stage )
+{
+    return p.then( std::forward<Stage>( stage ) );
+}
+
+template< typename... Stages, typename Stage >
+pipeline< Stages..., typename std::decay<Stage>::type > operator|( pipeline<Stages...> && p, Stage && stage )
+{
+    return std::move( p ).then( std::forward<Stage>( stage ) );
+}
+
+namespace status_value_detail {
+
+// Whether a range owns its elements, so that an rvalue of it may give them
+// up: its elements follow its constness, like those of a container and
+// unlike those of a span, and it is neither a view nor a borrowed range:
+
+template< typename Range >
+auto elements_follow_const( int ) -> std::integral_constant< bool, std::is_const< typename std::remove_reference< decltype( *std::begin( std::declval<Range const &>() ) ) >::type >::value >;
+
+template< typename Range >
+std::false_type elements_follow_const( long );
+
+template< typename Range >
+struct owns_elements : std::integral_constant< bool, decltype( elements_follow_const<Range>( 0 ) )::value
+#if nsstsv_HAVE_STD_RANGES
+    && ! std::ranges::view<Range> && ! std::ranges::borrowed_range<Range>
+#endif
+> {};
+
+// Element, status and value types of a range of status_values, and whether
+// to move from its elements: those of an rvalue range that owns them, or
+// prvalue elements:
+
+template< typename Range >
+struct collect_traits
+{
+    typedef decltype( *std::begin( std::declval<Range &>() ) ) element;
+    typedef typename std::decay< decltype( std::declval<element>().status() ) >::type status_type;
+    typedef typename std::decay< decltype( std::declval<element>().value() ) >::type value_type;
+
+    static constexpr bool moves = ( ! std::is_lvalue_reference<Range>::value && owns_elements< typename std::remove_cv< typename std::remove_reference<Range>::type >::type >::value )
+        || ! std::is_lvalue_reference<element>::value;
+};
+
+template< bool Move, typename Element >
+typename std::conditional< Move, Element &&, Element & >::type forward_element( Element & element ) nsstsv_noexcept
+{
+    return static_cast< typename std::conditional< Move, Element &&, Element & >::type >( element );
+}
+
+// Number of elements of a sized range, without traversing it: via
+// std::ranges::size(), else of a range with size(), an array, or a range
+// with random-access iterators:
+
+#if nsstsv_HAVE_STD_RANGES
+
+template< typename Range >
+auto range_size( Range & range, int ) -> decltype( std::size_t( std::ranges::size( range ) ) )
+{
+    return static_cast<std::size_t>( std::ranges::size( range ) );
+}
+
+#else // nsstsv_HAVE_STD_RANGES
+
+template< typename Range >
+auto range_size( Range & range, int ) -> decltype( std::size_t( range.size() ) )
+{
+    return static_cast<std::size_t>( range.size() );
+}
+
+template< typename T, std::size_t N >
+std::size_t range_size( T ( & )[N], int ) nsstsv_noexcept
+{
+    return N;
+}
+
+template< typename Range >
+auto range_size( Range & range, long ) -> typename std::enable_if<
+    std::is_base_of< std::random_access_iterator_tag, typename std::iterator_traits< decltype( std::begin( range ) ) >::iterator_category >::value, std::size_t >::type
+{
+    return static_cast<std::size_t>( std::distance( std::begin( range ), std::end( range ) ) );
+}
+
+#endif // nsstsv_HAVE_STD_RANGES
+
+// Reserve room for the elements of range if it knows its size:
+
+template< typename Container, typename Range >
+auto reserve_for( Container & container, Range & range, int ) -> decltype( container.reserve( std::size_t() ), void( range_size( range, 0 ) ) )
+{
+    container.reserve( container.size() + range_size( range, 0 ) );
+}
+
+template< typename Container, typename Range >
+void reserve_for( Container &, Range &, long ) {}
+
+} // namespace status_value_detail
+
+// Append the values of a range of status_values to container, via push_back(),
+// until the first failure:
+//
+// Returns the number of values appended with status success, or the status of
+// the first failure, after which the values before it remain appended. Room is
+// reserved up front for a sized range, and values are moved out of an
+// rvalue range that owns its elements, such as a container but not a span or
+// a view, or out of prvalue elements.
+
+template< typename Range, typename Container
+    , typename S = typename status_value_detail::collect_traits<Range>::status_type
+>
+status_value< S, std::size_t > collect_into( Range && range, Container & container, typename status_value_detail::collect_traits<Range>::status_type success = S() )
+{
+    typedef status_value_detail::collect_traits<Range> traits;
+
+    status_value_detail::reserve_for( container, range, 0 );
+
+    std::size_t n = 0;
+
+    for ( auto && element : range )
+    {
+        if ( ! element.has_value() )
+            return status_value< S, std::size_t >( status_value_detail::forward_element<traits::moves>( element ).status() );
+
+        container.push_back( status_value_detail::unchecked_access::value( status_value_detail::forward_element<traits::moves>( element ) ) );
+        ++n;
+    }
+    return status_value< S, std::size_t >( std::move( success ), n );
+}
+
+// All or nothing: the values of a range of status_values with status success,
+// or the status of the first failure:
+
+template< typename Range
+    , typename S = typename status_value_detail::collect_traits<Range>::status_type
+    , typename V = typename status_value_detail::collect_traits<Range>::value_type
+>
+status_value< S, std::vector<V> > collect( Range && range, typename status_value_detail::collect_traits<Range>::status_type success = S() )
+{
+    std::vector<V> values;
+
+    status_value< S, std::size_t > sv = collect_into( std::forward<Range>( range ), values, std::move( success ) );
+
+    if ( ! sv )
+        return status_value< S, std::vector<V> >( std::move( sv ).status() );
+
+    return status_value< S, std::vector<V> >( std::move( sv ).status(), std::move( values ) );
+}
+
+// The values of a range of status_values, or the statuses of all its failures
+// accumulated in order; values are no longer collected after the first failure:
+
+template< std::size_t N = 4, typename Range
+    , typename S = typename status_value_detail::collect_traits<Range>::status_type
+    , typename V = typename status_value_detail::collect_traits<Range>::value_type
+>
+status_value< accumulated_status<S, N>, std::vector<V> > collect_all( Range && range )
+{
+    typedef status_value_detail::collect_traits<Range> traits;
+
+    std::vector<V> values;
+    accumulated_status<S, N> failures;
+
+    status_value_detail::reserve_for( values, range, 0 );
+
+    for ( auto && element : range )
+    {
+        if ( ! element.has_value() )
+        {
+            failures.push_back( status_value_detail::forward_element<traits::moves>( element ).status() );
+        }
+        else if ( failures.empty() )
+        {
+            values.push_back( status_value_detail::unchecked_access::value( status_value_detail::forward_element<traits::moves>( element ) ) );
+        }
+    }
+
+    if ( ! failures.empty() )
+        return status_value< accumulated_status<S, N>, std::vector<V> >( std::move( failures ) );
+
+    return status_value< accumulated_status<S, N>, std::vector<V> >( std::move( failures ), std::move( values ) );
+}
+
+#if nsstsv_HAVE_STD_RANGES
+
+namespace status_value_detail {
+
+// Yield the given reference, or a value moved out of it if it refers into a
+// prvalue element that does not outlive the dereference:
+
+template< typename Element, typename Result >
+constexpr decltype(auto) project_element( Result && result )
+{
+    if constexpr ( ! std::is_reference_v<Element> && ! std::is_lvalue_reference_v<Result> )
+        return std::remove_cvref_t<Result>( std::forward<Result>( result ) );
+    else
+        return std::forward<Result>( result );
+}
+
+struct engaged_value_of
+{
+    template< typename Element >
+    constexpr decltype(auto) operator()( Element && element ) const
+    {
+        return project_element<Element>( unchecked_access::value( std::forward<Element>( element ) ) );
+    }
+};
+
+struct status_of
+{
+    template< typename Element >
+    constexpr decltype(auto) operator()( Element && element ) const
+    {
+        return project_element<Element>( std::forward<Element>( element ).status() );
+    }
+};
+
+// View of the elements of V with has_value() equal to Engaged, projected:
+//
+// Like std::ranges::filter_view, the view is forward or bidirectional if V is,
+// and begin() finds the first element each time it is called. Each element's
+// engagement is tested once while iterating, not again on dereference.
+
+template< std::ranges::view V, bool Engaged, typename Project >
+    requires std::ranges::input_range<V>
+class engagement_view : public std::ranges::view_interface< engagement_view<V, Engaged, Project> >
+{
+public:
+    class iterator
+    {
+    public:
+        using iterator_concept =
+            std::conditional_t< std::ranges::bidirectional_range<V>, std::bidirectional_iterator_tag,
+            std::conditional_t< std::ranges::forward_range<V>, std::forward_iterator_tag, std::input_iterator_tag > >;
+        using iterator_category = std::input_iterator_tag;
+        using difference_type   = std::ranges::range_difference_t<V>;
+        using value_type        = std::remove_cvref_t< std::invoke_result_t< Project const &, std::ranges::range_reference_t<V> > >;
+
+        iterator() requires std::default_initializable< std::ranges::iterator_t<V> > = default;
+
+        constexpr iterator( engagement_view & parent, std::ranges::iterator_t<V> current )
+        : m_parent( &parent )
+        , m_current( std::move( current ) )
+        {}
+
+        constexpr std::ranges::iterator_t<V> const & base() const & noexcept
+        {
+            return m_current;
+        }
+
+        constexpr std::ranges::iterator_t<V> base() &&
+        {
+            return std::move( m_current );
+        }
+
+        constexpr decltype(auto) operator*() const
+        {
+            return Project()( *m_current );
+        }
+
+        constexpr iterator & operator++()
+        {
+            ++m_current;
+            m_parent->satisfy( m_current );
+            return *this;
+        }
+
+        constexpr void operator++( int )
+        {
+            ++*this;
+        }
+
+        constexpr iterator operator++( int ) requires std::ranges::forward_range<V>
+        {
+            iterator tmp = *this;
+            ++*this;
+            return tmp;
+        }
+
+        constexpr iterator & operator--() requires std::ranges::bidirectional_range<V>
+        {
+            do
+            {
+                --m_current;
+            }
+            while ( static_cast<bool>( ( *m_current ).has_value() ) != Engaged );
+
+            return *this;
+        }
+
+        constexpr iterator operator--( int ) requires std::ranges::bidirectional_range<V>
+        {
+            iterator tmp = *this;
+            --*this;
+            return tmp;
+        }
+
+        friend constexpr bool operator==( iterator const & a, iterator const & b )
+            requires std::equality_comparable< std::ranges::iterator_t<V> >
+        {
+            return a.m_current == b.m_current;
+        }
+
+        friend constexpr bool operator==( iterator const & it, std::default_sentinel_t )
+        {
+            return it.m_current == std::ranges::end( it.m_parent->m_base );
+        }
+
+    private:
+        engagement_view * m_parent = nullptr;
+        std::ranges::iterator_t<V> m_current = std::ranges::iterator_t<V>();
+    };
+
+    engagement_view() requires std::default_initializable<V> = default;
+
+    constexpr explicit engagement_view( V base )
+    : m_base( std::move( base ) )
+    {}
+
+    constexpr V base() const & requires std::copy_constructible<V>
+    {
+        return m_base;
+    }
+
+    constexpr V base() &&
+    {
+        return std::move( m_base );
+    }
+
+    constexpr iterator begin()
+    {
+        std::ranges::iterator_t<V> first = std::ranges::begin( m_base );
+        satisfy( first );
+        return iterator( *this, std::move( first ) );
+    }
+
+    constexpr auto end()
+    {
+        if constexpr ( std::ranges::common_range<V> )
+            return iterator( *this, std::ranges::end( m_base ) );
+        else
+            return std::default_sentinel;
+    }
+
+private:
+    // advance to the next element with the wanted engagement, if any:
+
+    constexpr void satisfy( std::ranges::iterator_t<V> & it )
+    {
+        auto const last = std::ranges::end( m_base );
+
+        while ( it != last && static_cast<bool>( ( *it ).has_value() ) != Engaged )
+        {
+            ++it;
+        }
+    }
+
+    V m_base = V();
+};
+
+// Range adaptor closure for engagement_view, to apply to a range or pipe it into:
+
+template< bool Engaged, typename Project >
+struct engagement_closure
+#if nsstsv_HAVE_RANGE_ADAPTOR_CLOSURE
+    : std::ranges::range_adaptor_closure< engagement_closure<Engaged, Project> >
+#endif
+{
+    template< std::ranges::viewable_range R >
+    constexpr auto operator()( R && r ) const
+    {
+        return engagement_view< std::views::all_t<R>, Engaged, Project >( std::views::all( std::forward<R>( r ) ) );
+    }
+
+#if ! nsstsv_HAVE_RANGE_ADAPTOR_CLOSURE
+    template< std::ranges::viewable_range R >
+    friend constexpr auto operator|( R && r, engagement_closure const & closure )
+    {
+        return closure( std::forward<R>( r ) );
+    }
+#endif
+};
+
+} // namespace status_value_detail
+
+// Views of a range of status_values: the values of the engaged elements, the
+// statuses of all elements, and the statuses of the failed elements.
+//
+// Elements are yielded by reference, or moved out of prvalue elements. The
+// statuses view keeps the category and size of the underlying range, the
+// others are at most bidirectional.
+
+template< typename V >
+using engaged_values_view = status_value_detail::engagement_view< V, true, status_value_detail::engaged_value_of >;
+
+template< typename V >
+using failures_view = status_value_detail::engagement_view< V, false, status_value_detail::status_of >;
+
+namespace views {
+
+inline constexpr status_value_detail::engagement_closure< true, status_value_detail::engaged_value_of > engaged_values{};
+
+inline constexpr status_value_detail::engagement_closure< false, status_value_detail::status_of > failures{};
+
+inline constexpr auto statuses = std::views::transform( status_value_detail::status_of() );
+
+} // namespace views
+
+#endif // nsstsv_HAVE_STD_RANGES
+
+} // namespace nonstd
+
+#endif // NONSTD_STATUS_VALUE_BATCH_HPP
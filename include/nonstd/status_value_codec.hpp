@@ -0,0 +1,739 @@
+// Copyright 2016-2022 by Martin Moene
+//
+// This version targets C++11 and later.
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Columnar encoding of batches of status_value for storage. Opt-in, on top
+// of nonstd/status_value_batch.hpp.
+
+#ifndef NONSTD_STATUS_VALUE_CODEC_HPP
+#define NONSTD_STATUS_VALUE_CODEC_HPP
+
+#include "status_value_batch.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+namespace nonstd {
+
+// Columnar encoding of a status_value_vector of integral or enumeration
+// statuses and trivially copyable values, for storage:
+//
+// Statuses are run-length encoded, with the codes of the runs relative to the
+// smallest and the run lengths each bit-packed at the smallest width that
+// holds them. Engagement is the bitmap of the batch, and the values of the
+// engaged elements follow raw or, for integral values, as zigzag deltas
+// bit-packed in blocks of 1024, each at the width its deltas need. The
+// encoding uses the byte order of the host; a batch starts with a 48-byte
+// header and each section is padded to a multiple of 8 bytes.
+
+enum class batch_value_encoding : std::uint8_t
+{
+    raw,
+    delta
+};
+
+enum class batch_format_errc
+{
+    ok,
+    truncated,
+    bad_magic,
+    byte_order_mismatch,
+    type_mismatch,
+    corrupt
+};
+
+namespace status_value_detail {
+
+// Number of bits to hold x:
+
+inline int bit_width( std::uint64_t x ) nsstsv_noexcept
+{
+#if nsstsv_HAVE_STD_POPCOUNT
+    return static_cast<int>( std::bit_width( x ) );
+#elif defined( __GNUC__ ) || defined( __clang__ )
+    return x == 0 ? 0 : 64 - __builtin_clzll( x );
+#else
+    int n = 0;
+    for ( ; x != 0; x >>= 1 )
+        ++n;
+    return n;
+#endif
+}
+
+inline std::uint64_t low_bits( int bits ) nsstsv_noexcept
+{
+    return bits == 64 ? ~std::uint64_t( 0 ) : ( std::uint64_t( 1 ) << bits ) - 1;
+}
+
+// Append bytes to a buffer, without value-initialising them first:
+
+inline void append_bytes( std::vector<unsigned char> & out, void const * data, std::size_t size )
+{
+    unsigned char const * const bytes = static_cast<unsigned char const *>( data );
+    out.insert( out.end(), bytes, bytes + size );
+}
+
+// Bit-packed fields, little end first, appended to a byte buffer as 64-bit
+// words, a few at a time:
+
+class bit_writer
+{
+public:
+    explicit bit_writer( std::vector<unsigned char> & out ) nsstsv_noexcept
+    : m_out( out ), m_word( 0 ), m_used( 0 ), m_count( 0 ) {}
+
+    void put( std::uint64_t x, int bits )
+    {
+        if ( bits == 0 )
+            return;
+
+        m_word |= x << m_used;
+        m_used += bits;
+
+        if ( m_used >= 64 )
+        {
+            push_word();
+            m_used -= 64;
+            m_word = m_used > 0 ? x >> ( bits - m_used ) : 0;
+        }
+    }
+
+    // start the next field at a word:
+
+    void align()
+    {
+        if ( m_used > 0 )
+        {
+            push_word();
+            m_word = 0;
+            m_used = 0;
+        }
+    }
+
+    void finish()
+    {
+        align();
+        flush();
+    }
+
+private:
+    enum : std::size_t { buffered_words = 64 };
+
+    void push_word()
+    {
+        m_words[ m_count++ ] = m_word;
+
+        if ( m_count == buffered_words )
+            flush();
+    }
+
+    void flush()
+    {
+        append_bytes( m_out, m_words, m_count * sizeof m_word );
+        m_count = 0;
+    }
+
+    std::vector<unsigned char> & m_out;
+    std::uint64_t m_words[ buffered_words ];
+    std::uint64_t m_word;
+    int m_used;
+    std::size_t m_count;
+};
+
+class bit_reader
+{
+public:
+    explicit bit_reader( unsigned char const * data ) nsstsv_noexcept
+    : m_data( data ), m_pos( 0 ) {}
+
+    std::uint64_t get( int bits ) nsstsv_noexcept
+    {
+        if ( bits == 0 )
+            return 0;
+
+        std::size_t const word = m_pos / 64;
+        int const offset = static_cast<int>( m_pos % 64 );
+
+        std::uint64_t x = load( word ) >> offset;
+
+        if ( offset + bits > 64 )
+            x |= load( word + 1 ) << ( 64 - offset );
+
+        m_pos += static_cast<std::size_t>( bits );
+        return x & low_bits( bits );
+    }
+
+private:
+    std::uint64_t load( std::size_t word ) const nsstsv_noexcept
+    {
+        std::uint64_t x;
+        std::memcpy( &x, m_data + 8 * word, sizeof x );
+        return x;
+    }
+
+    unsigned char const * m_data;
+    std::size_t m_pos;
+};
+
+inline std::size_t packed_bytes( std::uint64_t count, int bits ) nsstsv_noexcept
+{
+    return static_cast<std::size_t>( 8 * ( ( count * static_cast<std::uint64_t>( bits ) + 63 ) / 64 ) );
+}
+
+inline std::size_t padded_bytes( std::size_t n ) nsstsv_noexcept
+{
+    return ( n + 7 ) / 8 * 8;
+}
+
+// Deltas per block, which starts with a word holding their width:
+
+enum : std::size_t { delta_block = 1024 };
+
+inline std::size_t delta_blocks( std::size_t deltas ) nsstsv_noexcept
+{
+    return ( deltas + delta_block - 1 ) / delta_block;
+}
+
+// Code of an integral or enumeration status as its unsigned type, and back:
+
+template< typename S >
+struct status_code
+{
+    static_assert( ( std::is_integral<S>::value && ! std::is_same<S, bool>::value ) || std::is_enum<S>::value
+        , "encode_batch: status shall be an integral or enumeration type" );
+
+    using underlying = typename std::conditional< std::is_enum<S>::value, std::underlying_type<S>, std::common_type<S> >::type::type;
+    using unsigned_type = typename std::make_unsigned<underlying>::type;
+
+    static underlying code( S s ) nsstsv_noexcept
+    {
+        return static_cast<underlying>( s );
+    }
+
+    static S status( unsigned_type u ) nsstsv_noexcept
+    {
+        return static_cast<S>( static_cast<underlying>( u ) );
+    }
+};
+
+// Integral values as delta, or raw:
+
+template< typename V >
+struct value_delta
+{
+    static constexpr bool applies = std::is_integral<V>::value && ! std::is_same<V, bool>::value;
+};
+
+template< typename V, bool = value_delta<V>::applies >
+struct zigzag
+{
+    typedef typename std::make_unsigned<V>::type unsigned_type;
+
+    static std::uint64_t encode( V prev, V x ) nsstsv_noexcept
+    {
+        unsigned_type const d = static_cast<unsigned_type>( static_cast<unsigned_type>( x ) - static_cast<unsigned_type>( prev ) );
+        unsigned_type const sign = static_cast<unsigned_type>( 0 - ( d >> ( 8 * sizeof(V) - 1 ) ) );
+
+        return static_cast<unsigned_type>( static_cast<unsigned_type>( d << 1 ) ^ sign );
+    }
+
+    static V decode( V prev, std::uint64_t z ) nsstsv_noexcept
+    {
+        unsigned_type const u = static_cast<unsigned_type>( z );
+        unsigned_type const d = static_cast<unsigned_type>( ( u >> 1 ) ^ static_cast<unsigned_type>( 0 - ( u & 1u ) ) );
+
+        return static_cast<V>( static_cast<unsigned_type>( static_cast<unsigned_type>( prev ) + d ) );
+    }
+};
+
+template< typename V >
+struct zigzag< V, false >
+{
+    static std::uint64_t encode( V, V ) nsstsv_noexcept { return 0; }
+    static V decode( V prev, std::uint64_t ) nsstsv_noexcept { return prev; }
+};
+
+// Kind of a status or value type, so that types of the same size but of a
+// different kind do not decode as each other; enumerations take the kind of
+// their underlying type:
+
+enum : std::uint8_t { kind_other, kind_signed, kind_unsigned, kind_floating_point };
+
+template< typename T, bool = std::is_enum<T>::value >
+struct type_kind
+{
+    static constexpr std::uint8_t value = std::is_floating_point<T>::value ? kind_floating_point
+        : std::is_integral<T>::value ? ( std::is_signed<T>::value ? kind_signed : kind_unsigned ) : kind_other;
+};
+
+template< typename T >
+struct type_kind< T, true > : type_kind< typename std::underlying_type<T>::type > {};
+
+// Header, in the byte order of the host, which byte_order records:
+
+enum : std::uint16_t { batch_byte_order = 0x0102 };
+
+struct batch_header
+{
+    char magic[4];
+    std::uint8_t version;
+    std::uint8_t value_encoding;
+    std::uint8_t status_size;
+    std::uint8_t value_size;
+    std::uint64_t size;
+    std::uint64_t runs;
+    std::uint64_t engaged;
+    std::uint64_t code_base;
+    std::uint8_t code_bits;
+    std::uint8_t length_bits;
+    std::uint8_t delta_bits;
+    std::uint8_t status_kind;
+    std::uint16_t byte_order;
+    std::uint8_t value_kind;
+    std::uint8_t reserved;
+};
+
+static_assert( sizeof( batch_header ) == 48, "batch_header: unexpected padding" );
+
+// Whether the 16 statuses at p equal those of pattern, compared 8 bytes at a
+// time, as integral and enumeration statuses have no padding:
+
+template< typename S >
+bool same_statuses( S const * p, S const * pattern ) nsstsv_noexcept
+{
+    unsigned char const * a = reinterpret_cast<unsigned char const *>( p );
+    unsigned char const * b = reinterpret_cast<unsigned char const *>( pattern );
+    std::uint64_t diff = 0;
+
+    for ( std::size_t q = 0; q < 16 * sizeof(S); q += 8 )
+    {
+        std::uint64_t x, y;
+        std::memcpy( &x, a + q, 8 );
+        std::memcpy( &y, b + q, 8 );
+        diff |= x ^ y;
+    }
+    return diff == 0;
+}
+
+struct batch_codec
+{
+    template< typename S, typename V >
+    static void encode( status_value_vector<S, V> const & batch, std::vector<unsigned char> & out, batch_value_encoding encoding );
+
+    template< typename S, typename V >
+    static status_value< batch_format_errc, std::size_t > decode( unsigned char const * data, std::size_t size, status_value_vector<S, V> & out );
+};
+
+template< typename S, typename V >
+void batch_codec::encode( status_value_vector<S, V> const & batch, std::vector<unsigned char> & out, batch_value_encoding encoding )
+{
+    typedef status_code<S> codes;
+    typedef typename codes::underlying underlying;
+    typedef typename codes::unsigned_type unsigned_type;
+
+    struct run
+    {
+        underlying code;
+        std::uint64_t length;
+    };
+
+    std::size_t const n = batch.size();
+    S const * statuses = batch.statuses();
+
+    // runs, smallest code and widths:
+
+    std::vector<run> runs;
+    underlying min_code = 0;
+    std::uint64_t max_length = 0;
+
+    for ( std::size_t i = 0; i < n; )
+    {
+        S pattern[16];
+        std::fill( pattern, pattern + 16, statuses[i] );
+
+        std::size_t j = i + 1;
+        while ( j + 16 <= n && same_statuses( statuses + j, pattern ) )
+            j += 16;
+        while ( j < n && statuses[j] == statuses[i] )
+            ++j;
+
+        run const r = { codes::code( statuses[i] ), j - i - 1 };
+        runs.push_back( r );
+
+        min_code = runs.size() == 1 || r.code < min_code ? r.code : min_code;
+        max_length = r.length > max_length ? r.length : max_length;
+        i = j;
+    }
+
+    std::uint64_t max_offset = 0;
+
+    for ( run const & r : runs )
+    {
+        max_offset |= static_cast<unsigned_type>( static_cast<unsigned_type>( r.code ) - static_cast<unsigned_type>( min_code ) );
+    }
+
+    std::size_t const engaged = batch.count_engaged();
+    bool const delta = encoding == batch_value_encoding::delta && value_delta<V>::applies && engaged > 0;
+
+    batch_header header = {};
+    std::memcpy( header.magic, "SVB1", 4 );
+    header.version        = 1;
+    header.value_encoding = static_cast<std::uint8_t>( delta ? batch_value_encoding::delta : batch_value_encoding::raw );
+    header.status_size    = static_cast<std::uint8_t>( sizeof(S) );
+    header.value_size     = static_cast<std::uint8_t>( sizeof(V) );
+    header.status_kind    = type_kind<S>::value;
+    header.value_kind     = type_kind<V>::value;
+    header.byte_order     = batch_byte_order;
+    header.size           = n;
+    header.runs           = runs.size();
+    header.engaged        = engaged;
+    header.code_base      = static_cast<unsigned_type>( min_code );
+    header.code_bits      = static_cast<std::uint8_t>( bit_width( max_offset ) );
+    header.length_bits    = static_cast<std::uint8_t>( bit_width( max_length ) );
+
+    // room for all but the packed deltas, whose widths are not known yet:
+
+    std::size_t const words = status_value_vector<S, V>::word_count( n );
+    std::size_t const value_bytes = delta
+        ? padded_bytes( sizeof(V) ) + 8 * delta_blocks( engaged - 1 )
+        : padded_bytes( engaged * sizeof(V) );
+
+    std::size_t const offset = out.size();
+
+    out.reserve( offset + sizeof header + packed_bytes( runs.size(), header.code_bits ) + packed_bytes( runs.size(), header.length_bits ) + 8 * words + value_bytes );
+
+    append_bytes( out, &header, sizeof header );
+
+    // statuses, the codes of all runs followed by their lengths less one:
+
+    bit_writer writer( out );
+
+    for ( run const & r : runs )
+    {
+        writer.put( static_cast<unsigned_type>( static_cast<unsigned_type>( r.code ) - static_cast<unsigned_type>( min_code ) ), header.code_bits );
+    }
+    writer.align();
+
+    for ( run const & r : runs )
+    {
+        writer.put( r.length, header.length_bits );
+    }
+    writer.finish();
+
+    // engagement and values:
+
+    std::uint64_t const * engaged_words = batch.engaged_words();
+    V const * slots = batch.values();
+    std::uint64_t const padding = 0;
+
+    append_bytes( out, engaged_words, 8 * words );
+
+    if ( delta )
+    {
+        // the first value, then blocks of zigzag deltas, each computed once
+        // into a bounded scratch buffer and packed at the width of its block:
+
+        std::uint64_t deltas[ delta_block ];
+        std::size_t count = 0;
+        std::uint64_t block_max = 0;
+        int widest = 0;
+        V const * prev = nullptr;
+
+        auto const put_block = [&]
+        {
+            int const bits = bit_width( block_max );
+
+            writer.put( static_cast<std::uint64_t>( bits ), 64 );
+
+            for ( std::size_t k = 0; k < count; ++k )
+                writer.put( deltas[k], bits );
+
+            writer.align();
+            widest = bits > widest ? bits : widest;
+            count = 0;
+            block_max = 0;
+        };
+
+        for ( std::size_t wi = 0; wi < words; ++wi )
+        {
+            for ( std::uint64_t w = engaged_words[wi]; w != 0; w &= w - 1 )
+            {
+                V const * x = slots + 64 * wi + countr_zero( w );
+
+                if ( ! prev )
+                {
+                    append_bytes( out, x, sizeof(V) );
+                    append_bytes( out, &padding, padded_bytes( sizeof(V) ) - sizeof(V) );
+                }
+                else
+                {
+                    std::uint64_t const z = zigzag<V>::encode( *prev, *x );
+
+                    deltas[ count++ ] = z;
+                    block_max |= z;
+
+                    if ( count == delta_block )
+                        put_block();
+                }
+                prev = x;
+            }
+        }
+
+        if ( count > 0 )
+            put_block();
+
+        writer.finish();
+
+        header.delta_bits = static_cast<std::uint8_t>( widest );
+        std::memcpy( out.data() + offset, &header, sizeof header );
+    }
+    else
+    {
+        // values of the engaged elements, stretches of words with all elements
+        // engaged as is, and the values of other words compacted into a
+        // scratch buffer of a bounded number of bytes, or run by run:
+
+        append_engaged_values( detected_simd_isa(), slots, engaged_words, n,
+            [&out]( V const * first, std::size_t count ) { append_bytes( out, first, count * sizeof(V) ); } );
+
+        append_bytes( out, &padding, padded_bytes( engaged * sizeof(V) ) - engaged * sizeof(V) );
+    }
+}
+
+template< typename S, typename V >
+status_value< batch_format_errc, std::size_t >
+batch_codec::decode( unsigned char const * data, std::size_t size, status_value_vector<S, V> & out )
+{
+    typedef status_code<S> codes;
+    typedef typename codes::unsigned_type unsigned_type;
+    typedef status_value< batch_format_errc, std::size_t > result;
+
+    out.clear();
+
+    batch_header header;
+
+    if ( size < sizeof header )
+        return result( batch_format_errc::truncated );
+
+    std::memcpy( &header, data, sizeof header );
+
+    if ( std::memcmp( header.magic, "SVB1", 4 ) != 0 || header.version != 1 )
+        return result( batch_format_errc::bad_magic );
+
+    if ( header.byte_order != batch_byte_order )
+        return result( batch_format_errc::byte_order_mismatch );
+
+    if ( header.status_size != sizeof(S) || header.value_size != sizeof(V) || header.value_encoding > 1
+        || header.status_kind != type_kind<S>::value || header.value_kind != type_kind<V>::value
+        || ( header.value_encoding == 1 && ! value_delta<V>::applies ) )
+        return result( batch_format_errc::type_mismatch );
+
+    std::size_t const available = size - sizeof header;
+
+    if ( header.size / 64 > available / 8 )
+        return result( batch_format_errc::truncated );
+
+    if ( header.runs > header.size || ( header.runs == 0 ) != ( header.size == 0 ) || header.engaged > header.size
+        || header.code_bits > 8 * sizeof(S) || header.length_bits > 64 || header.delta_bits > 8 * sizeof(V) )
+        return result( batch_format_errc::corrupt );
+
+    bool const delta = header.value_encoding == 1 && header.engaged > 0;
+    std::size_t const n = static_cast<std::size_t>( header.size );
+    std::size_t const runs = static_cast<std::size_t>( header.runs );
+    std::size_t const engaged = static_cast<std::size_t>( header.engaged );
+    std::size_t const words = status_value_vector<S, V>::word_count( n );
+
+    // all but the delta blocks, whose sizes follow from their widths:
+
+    std::size_t const code_bytes   = packed_bytes( runs, header.code_bits );
+    std::size_t const length_bytes = packed_bytes( runs, header.length_bits );
+    std::size_t const value_bytes  = delta
+        ? padded_bytes( sizeof(V) )
+        : padded_bytes( engaged * sizeof(V) );
+    std::size_t const total = code_bytes + length_bytes + 8 * words + value_bytes;
+
+    if ( total > available )
+        return result( batch_format_errc::truncated );
+
+    unsigned char const * p = data + sizeof header;
+
+    // run lengths, which shall add up to the size before room is taken for it:
+
+    bit_reader length_reader( p + code_bytes );
+    std::uint64_t remaining = n;
+
+    for ( std::size_t r = 0; r < runs; ++r )
+    {
+        std::uint64_t const length = length_reader.get( header.length_bits ) + 1;
+
+        if ( length == 0 || length > remaining )
+            return result( batch_format_errc::corrupt );
+
+        remaining -= length;
+    }
+
+    if ( remaining != 0 )
+        return result( batch_format_errc::corrupt );
+
+    // room for all elements, taken along with the statuses and engagement
+    // while out stays empty:
+
+    out.reserve( n );
+
+    // statuses, expanded from their runs:
+
+    std::vector<S> statuses;
+    statuses.swap( out.m_statuses );
+
+    bit_reader code_reader( p );
+    length_reader = bit_reader( p + code_bytes );
+
+    for ( std::size_t r = 0; r < runs; ++r )
+    {
+        unsigned_type const code = static_cast<unsigned_type>( header.code_base + code_reader.get( header.code_bits ) );
+        std::size_t const length = static_cast<std::size_t>( length_reader.get( header.length_bits ) + 1 );
+
+        statuses.insert( statuses.end(), length, codes::status( code ) );
+    }
+
+    p += code_bytes + length_bytes;
+
+    // engagement, with no bits beyond size:
+
+    std::vector<std::uint64_t> engaged_words;
+    engaged_words.swap( out.m_engaged );
+    engaged_words.resize( words );
+
+    if ( words > 0 )
+        std::memcpy( engaged_words.data(), p, 8 * words );
+    p += 8 * words;
+
+    std::size_t count = 0;
+    for ( std::uint64_t w : engaged_words )
+        count += static_cast<std::size_t>( popcount( w ) );
+
+    if ( count != engaged || ( n % 64 != 0 && ( engaged_words.back() >> ( n % 64 ) ) != 0 ) )
+        return result( batch_format_errc::corrupt );
+
+    // values, into the slots of the engaged elements:
+
+    V * slots = out.m_values;
+
+    unsigned char const * end = p + value_bytes;
+
+    if ( delta )
+    {
+        V value;
+        std::memcpy( &value, p, sizeof(V) );
+
+        bit_reader delta_reader( end );
+        std::size_t deltas = engaged - 1;
+        std::size_t in_block = 0;
+        int bits = 0;
+        bool first = true;
+
+        for ( std::size_t wi = 0; wi < words; ++wi )
+        {
+            for ( std::uint64_t w = engaged_words[wi]; w != 0; w &= w - 1 )
+            {
+                if ( ! first )
+                {
+                    if ( in_block == 0 )
+                    {
+                        std::uint64_t width;
+
+                        if ( static_cast<std::size_t>( data + size - end ) < sizeof width )
+                            return result( batch_format_errc::truncated );
+
+                        std::memcpy( &width, end, sizeof width );
+                        end += sizeof width;
+
+                        if ( width > header.delta_bits )
+                            return result( batch_format_errc::corrupt );
+
+                        in_block = deltas < delta_block ? deltas : delta_block;
+                        bits = static_cast<int>( width );
+                        deltas -= in_block;
+
+                        if ( packed_bytes( in_block, bits ) > static_cast<std::size_t>( data + size - end ) )
+                            return result( batch_format_errc::truncated );
+
+                        delta_reader = bit_reader( end );
+                        end += packed_bytes( in_block, bits );
+                    }
+                    value = zigzag<V>::decode( value, delta_reader.get( bits ) );
+                    --in_block;
+                }
+
+                std::memcpy( slots + 64 * wi + countr_zero( w ), &value, sizeof(V) );
+                first = false;
+            }
+        }
+    }
+    else
+    {
+        unsigned char const * src = p;
+
+        for ( std::size_t wi = 0; wi < words; ++wi )
+        {
+            std::uint64_t w = engaged_words[wi];
+
+            if ( w == ~std::uint64_t( 0 ) )
+            {
+                std::memcpy( slots + 64 * wi, src, 64 * sizeof(V) );
+                src += 64 * sizeof(V);
+                continue;
+            }
+
+            for ( ; w != 0; w &= w - 1 )
+            {
+                std::memcpy( slots + 64 * wi + countr_zero( w ), src, sizeof(V) );
+                src += sizeof(V);
+            }
+        }
+    }
+
+    out.m_statuses.swap( statuses );
+    out.m_engaged.swap( engaged_words );
+    out.m_size = n;
+
+    return result( batch_format_errc::ok, static_cast<std::size_t>( end - data ) );
+}
+
+} // namespace status_value_detail
+
+// Append the encoding of batch to out; delta applies to integral values, other
+// values are stored raw:
+
+template< typename S, typename V >
+void encode_batch( status_value_vector<S, V> const & batch, std::vector<unsigned char> & out, batch_value_encoding encoding = batch_value_encoding::raw )
+{
+    static_assert( std::is_trivially_copyable<V>::value, "encode_batch: value shall be trivially copyable" );
+    static_assert( sizeof(V) < 256, "encode_batch: value shall be smaller than 256 bytes, the greatest size the header records" );
+
+    status_value_detail::batch_codec::encode( batch, out, encoding );
+}
+
+// Replace the contents of out by the batch encoded at data, of at most size
+// bytes; returns the number of bytes read, or the status of a malformed or
+// mismatching encoding, after which out is empty:
+
+template< typename S, typename V >
+status_value< batch_format_errc, std::size_t > decode_batch( unsigned char const * data, std::size_t size, status_value_vector<S, V> & out )
+{
+    static_assert( std::is_trivially_copyable<V>::value, "decode_batch: value shall be trivially copyable" );
+    static_assert( sizeof(V) < 256, "decode_batch: value shall be smaller than 256 bytes, the greatest size the header records" );
+
+    return status_value_detail::batch_codec::decode( data, size, out );
+}
+
+} // namespace nonstd
+
+#endif // NONSTD_STATUS_VALUE_CODEC_HPP
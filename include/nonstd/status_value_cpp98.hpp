@@ -126,6 +126,18 @@
 #define nsstsv_HAVE_NULLPTR        nsstsv_CPP11_000
 #define nsstsv_HAVE_REF_QUALIFIER  nsstsv_CPP11_140
 
+// Presence of alignment facilities, standard or as compiler extension:
+
+#define nsstsv_HAVE_ALIGNAS  ( nsstsv_CPP11_OR_GREATER || nsstsv_COMPILER_MSVC_VER >= 1900 )
+
+#if ! nsstsv_HAVE_ALIGNAS && defined(__GNUC__)
+# define nsstsv_HAVE_GNUC_ALIGN_ATTRIBUTE  1
+#else
+# define nsstsv_HAVE_GNUC_ALIGN_ATTRIBUTE  0
+#endif
+
+#define nsstsv_HAVE_MSVC_ALIGN_DECLSPEC  ( ! nsstsv_HAVE_ALIGNAS && nsstsv_COMPILER_MSVC_VER >= 1300 )
+
 // Presence of C++14 language features:
 
 #define nsstsv_HAVE_CONSTEXPR_14   nsstsv_CPP14_000
@@ -193,13 +205,17 @@
  *
  * If optional lite is compiled as C++11 or later, C++11 alignment facilities
  * are used for storage of the underlying object. When compiling with C++03,
- * optional lite tries to determine proper alignment using meta programming.
- * If this doesn't work out, you can control alignment via three macros.
+ * optional lite uses the alignment extensions of the compiler, or else tries
+ * to determine proper alignment using meta programming. If this doesn't work
+ * out, you can control alignment via three macros.
  *
  * optional lite uses the following rules for alignment:
  *
  * 1. If the program compiles as C++11 or later, C++11 alignment facilities
- * are used.
+ * are used. Before C++11, the compiler's alignment extensions are used if
+ * available: __attribute__((aligned)) with __alignof__ (GNUC, clang), or
+ * __declspec(align) with __alignof (MSVC). Both honour over-aligned types,
+ * such as SIMD vectors and cache-line aligned blocks.
  *
  * 2. If you define -Dnsstsv_CONFIG_MAX_ALIGN_HACK=1 the underlying
  * type is aligned as the most restricted type in `struct max_align_t`. This
@@ -244,6 +260,68 @@ namespace nonstd {
 template< typename S, typename V >
 class status_value;
 
+// Move emulation for C++98:
+//
+// nonstd::move( x ) yields x as rv<T> &, which selects the moving constructor
+// of status_value. Use return nonstd::move( result ) to pass a named result up
+// without copying it. Status and value are moved by default construction and
+// member swap() if swap_movable<> holds for their type, otherwise copied.
+// In C++11 and later, nonstd::move is std::move.
+
+#if nsstsv_CPP11_OR_GREATER
+
+using std::move;
+
+#else // nsstsv_CPP11_OR_GREATER
+
+#if defined(__GNUC__)
+# define nsstsv_MAY_ALIAS  __attribute__(( __may_alias__ ))
+#else
+# define nsstsv_MAY_ALIAS  /*may_alias*/
+#endif
+
+template< typename T >
+class nsstsv_MAY_ALIAS rv : public T
+{
+    rv();
+    ~rv() throw();
+    rv( rv const & );
+    void operator=( rv const & );
+};
+
+#undef nsstsv_MAY_ALIAS
+
+template< typename T >
+inline rv<T> & move( T & x )
+{
+    return *static_cast< rv<T> * >( &x );
+}
+
+namespace status_value_detail {
+
+template< typename T >
+struct has_member_swap
+{
+    template< typename U, void (U::*)( U & ) > struct check;
+
+    template< typename U > static char test( check< U, &U::swap > * );
+    template< typename U > static long test( ... );
+
+    enum { value = sizeof( test<T>( 0 ) ) == sizeof( char ) };
+};
+
+} // namespace status_value_detail
+
+// Specialize to indicate T can be moved by default construction and member swap():
+
+template< typename T >
+struct swap_movable
+{
+    enum { value = status_value_detail::has_member_swap<T>::value };
+};
+
+#endif // nsstsv_CPP11_OR_GREATER
+
 namespace status_value_detail {
 
 #if nsstsv_CONFIG_MAX_ALIGN_HACK
@@ -449,6 +527,78 @@ typedef
 
 #endif // nsstsv_CONFIG_MAX_ALIGN_HACK
 
+#if nsstsv_HAVE_MSVC_ALIGN_DECLSPEC
+
+// Block of Align bytes aligned at Align; __declspec(align()) requires a literal:
+
+template< size_t Align >
+struct aligned_block;
+
+#define nsstsv_ALIGNED_BLOCK( n ) \
+    template<> \
+    struct __declspec( align( n ) ) aligned_block< n > \
+    { \
+        unsigned char data[ n ]; \
+    }
+
+nsstsv_ALIGNED_BLOCK(   1 );
+nsstsv_ALIGNED_BLOCK(   2 );
+nsstsv_ALIGNED_BLOCK(   4 );
+nsstsv_ALIGNED_BLOCK(   8 );
+nsstsv_ALIGNED_BLOCK(  16 );
+nsstsv_ALIGNED_BLOCK(  32 );
+nsstsv_ALIGNED_BLOCK(  64 );
+nsstsv_ALIGNED_BLOCK( 128 );
+
+#undef nsstsv_ALIGNED_BLOCK
+
+#endif // nsstsv_HAVE_MSVC_ALIGN_DECLSPEC
+
+#if ! nsstsv_CPP11_OR_GREATER
+
+// Move-initialization of a member: an empty object to swap the source into, or a copy:
+
+template< bool B >
+struct swap_tag {};
+
+template< typename T >
+inline T move_init( T &, swap_tag<true> )
+{
+    return T();
+}
+
+template< typename T >
+inline T const & move_init( T & from, swap_tag<false> )
+{
+    return from;
+}
+
+template< typename T >
+inline void move_complete( T & to, T & from, swap_tag<true> )
+{
+    to.swap( from );
+}
+
+template< typename T >
+inline void move_complete( T &, T &, swap_tag<false> ) {}
+
+// Move-construction in place:
+
+template< typename T >
+inline void move_construct( void * p, T & from, swap_tag<true> )
+{
+    T * to = ::new( p ) T();
+    to->swap( from );
+}
+
+template< typename T >
+inline void move_construct( void * p, T & from, swap_tag<false> )
+{
+    ::new( p ) T( from );
+}
+
+#endif // nsstsv_CPP11_OR_GREATER
+
 /// C++98 union to hold value.
 
 template< typename S, typename V >
@@ -479,6 +629,12 @@ private:
     {
         new( value_ptr() ) value_type( std::move( v ) );
     }
+#else
+
+    void move_construct_value( value_type & v )
+    {
+        move_construct( value_ptr(), v, swap_tag< swap_movable<value_type>::value >() );
+    }
 #endif
 
     void destruct_value() nsstsv_noexcept
@@ -527,9 +683,21 @@ private:
         return as( (value_type*) nsstsv_nullptr );
     }
 
-#if nsstsv_CPP11_OR_GREATER
+#if nsstsv_HAVE_ALIGNAS
+
+    struct aligned_storage_t { alignas( value_type ) unsigned char data[ sizeof(value_type) ]; };
+    aligned_storage_t buffer;
+
+#elif nsstsv_HAVE_GNUC_ALIGN_ATTRIBUTE
+
+    struct aligned_storage_t { unsigned char data[ sizeof(value_type) ]; } __attribute__(( aligned( __alignof__( value_type ) ) ));
+    aligned_storage_t buffer;
+
+#elif nsstsv_HAVE_MSVC_ALIGN_DECLSPEC
+
+    typedef aligned_block< __alignof( value_type ) > align_as_type;
 
-    using aligned_storage_t = typename std::aligned_storage< sizeof(value_type), alignof(value_type) >::type;
+    typedef struct { align_as_type data[ 1 + ( sizeof(value_type) - 1 ) / sizeof(align_as_type) ]; } aligned_storage_t;
     aligned_storage_t buffer;
 
 #elif nsstsv_CONFIG_MAX_ALIGN_HACK
@@ -599,6 +767,9 @@ public:
   , m_status( s )
   {}
 
+  // match the exception specification of ~logic_error() for S like std::string
+  ~bad_status_value_access() throw() {}
+
 #else // nsstsv_CPP11_OR_GREATER
 
 public:
@@ -714,6 +885,24 @@ public:
             contained.construct_value( other.contained.value() );
         }
     }
+
+    // Move emulation, selected by nonstd::move( other ):
+
+    status_value( rv<status_value> & other )
+    : m_status   ( status_value_detail::move_init( static_cast<status_value &>( other ).m_status, status_swap_tag() ) )
+    , m_has_value( static_cast<status_value &>( other ).m_has_value )
+    {
+        status_value & src = other;
+
+        status_value_detail::move_complete( m_status, src.m_status, status_swap_tag() );
+
+        if ( src.m_has_value )
+        {
+            contained.move_construct_value( src.contained.value() );
+            src.contained.destruct_value();
+            src.m_has_value = false;
+        }
+    }
 #endif // nsstsv_CPP11_OR_GREATER
 
     // ?.?.3.2 destructor
@@ -848,6 +1037,10 @@ public:
 private:
     typedef status_value_detail::storage_t<status_type, value_type > storage_type;
 
+#if ! nsstsv_CPP11_OR_GREATER
+    typedef status_value_detail::swap_tag< swap_movable<status_type>::value > status_swap_tag;
+#endif
+
     storage_type contained;
     status_type m_status;
     bool m_has_value;
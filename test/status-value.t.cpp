@@ -10,6 +10,8 @@
 //   by Lawrence Crowl and Chris Mysen
 
 #include nsstv_STATUS_VALUE_HEADER
+#include "nonstd/status_value_batch.hpp"
+#include "nonstd/status_value_codec.hpp"
 
 #ifdef __clang__
 # pragma clang diagnostic ignored "-Wstring-conversion"
@@ -24,6 +26,23 @@
 
 #include "lest.hpp"
 
+#include <cstring>
+#include <sstream>
+#include <string>
+#include <thread>
+
+#if nsstsv_CPP17_OR_GREATER && defined( __has_include )
+# if __has_include( <memory_resource> )
+#  include <memory_resource>
+#  include <vector>
+#  define nsstsv_TEST_HAVE_MEMORY_RESOURCE  1
+# endif
+#endif
+
+#ifndef  nsstsv_TEST_HAVE_MEMORY_RESOURCE
+# define nsstsv_TEST_HAVE_MEMORY_RESOURCE  0
+#endif
+
 #ifndef nsstsv_CONFIG_CONFIRMS_COMPILATION_ERRORS
 #define nsstsv_CONFIG_CONFIRMS_COMPILATION_ERRORS  0
 #endif
@@ -136,6 +155,15 @@ CASE( "status_value<>: Allows to observe its status" )
     EXPECT( sv.status() == 7 );
 }
 
+CASE( "status_value<>: Allows to move its status out of an r-value" )
+{
+    status_value<std::string, int> sv( "failure" );
+
+    std::string status = std::move( sv ).status();
+
+    EXPECT( status == "failure" );
+}
+
 // They may be queried for whether or not they have a value.
 
 CASE( "status_value<>: Allows to observe the presence of a value (has_value())" )
@@ -322,6 +350,2942 @@ CASE( "status_value<>: Throws when observing non-engaged (operator->())" )
 #endif
 }
 
+// -----------------------------------------------------------------------
+// boxed_status<>
+
+struct error_details
+{
+    int code;
+    char message[120];
+
+    error_details( int code_ ) : code( code_ ), message() {}
+};
+
+inline bool operator==( error_details const & a, error_details const & b )
+{
+    return a.code == b.code;
+}
+
+template< typename T >
+struct counting_box_pool
+{
+    static int allocations;
+    static int deallocations;
+
+    static void * allocate()
+    {
+        ++allocations;
+        return heap_box_pool<T>::allocate();
+    }
+
+    static void deallocate( void * p ) noexcept
+    {
+        ++deallocations;
+        heap_box_pool<T>::deallocate( p );
+    }
+};
+
+template< typename T > int counting_box_pool<T>::allocations   = 0;
+template< typename T > int counting_box_pool<T>::deallocations = 0;
+
+CASE( "boxed_status<>: Is the size of a pointer and ok when default constructed" )
+{
+    boxed_status<error_details> bs;
+
+    EXPECT( sizeof( bs ) == sizeof( void * ) );
+    EXPECT( bs.ok() );
+    EXPECT( bs.get() == nullptr );
+    EXPECT( bs.use_count() == 0u );
+}
+
+CASE( "boxed_status<>: Allocates the details from the pool only on failure" )
+{
+    typedef boxed_status<error_details, box_unique, counting_box_pool> status;
+    typedef counting_box_pool< status::node_type > pool;
+
+    pool::allocations = pool::deallocations = 0;
+    {
+        status_value<status, int> ok( status(), 42 );
+        EXPECT( pool::allocations == 0 );
+
+        status_value<status, int> failed( make_boxed_status<error_details, box_unique, counting_box_pool>( 7 ) );
+        EXPECT( pool::allocations == 1 );
+        EXPECT( failed.status()->code == 7 );
+    }
+    EXPECT( pool::deallocations == 1 );
+}
+
+CASE( "boxed_status<>: Duplicates the details on copy with box_unique" )
+{
+    boxed_status<error_details> bs1( error_details( 7 ) );
+    boxed_status<error_details> bs2( bs1 );
+
+    EXPECT( bs1.get() != bs2.get() );
+    EXPECT( bs1 == bs2 );
+    EXPECT( bs2.use_count() == 1u );
+}
+
+CASE( "boxed_status<>: Shares the details on copy with box_refcount, box_atomic_refcount" )
+{
+    SETUP("") {
+    SECTION("non-atomic reference count")
+    {
+        boxed_status<error_details, box_refcount> bs1( error_details( 7 ) );
+        boxed_status<error_details, box_refcount> bs2( bs1 );
+
+        EXPECT( bs1.get() == bs2.get() );
+        EXPECT( bs2.use_count() == 2u );
+
+        bs1.reset();
+        EXPECT( bs1.ok() );
+        EXPECT( bs2.use_count() == 1u );
+        EXPECT( bs2->code == 7 );
+    }
+    SECTION("atomic reference count")
+    {
+        boxed_status<error_details, box_atomic_refcount> bs1( error_details( 7 ) );
+        boxed_status<error_details, box_atomic_refcount> bs2( bs1 );
+
+        EXPECT( bs1.get() == bs2.get() );
+        EXPECT( bs2.use_count() == 2u );
+    }}
+}
+
+CASE( "boxed_status<>: Leaves the moved-from status ok" )
+{
+    boxed_status<error_details> bs1( error_details( 7 ) );
+    boxed_status<error_details> bs2( std::move( bs1 ) );
+
+    EXPECT( bs1.ok() );
+    EXPECT( (*bs2).code == 7 );
+}
+
+CASE( "boxed_status<>: Reuses released blocks with freelist_box_pool" )
+{
+    typedef boxed_status<error_details, box_unique, freelist_box_pool> status;
+    typedef freelist_box_pool< status::node_type > pool;
+
+    void const * first = nullptr;
+    {
+        status bs( error_details( 7 ) );
+        first = bs.get();
+    }
+    EXPECT( pool::cached() == 1u );
+
+    status bs( error_details( 8 ) );
+
+    EXPECT( bs.get() == first );
+    EXPECT( pool::cached() == 0u );
+}
+
+// -----------------------------------------------------------------------
+// payload_status
+
+struct parse_position
+{
+    int line;
+    int column;
+};
+
+struct remote_error
+{
+    int code;
+    char host[60];
+};
+
+struct instance_counter
+{
+    static int instances;
+
+    instance_counter() { ++instances; }
+    instance_counter( instance_counter const & ) { ++instances; }
+    instance_counter( instance_counter && ) noexcept { ++instances; }
+    ~instance_counter() { --instances; }
+};
+
+int instance_counter::instances = 0;
+
+CASE( "payload_status: Allows construction from only a code" )
+{
+    payload_status ps( 7 );
+
+    EXPECT( ps.code() == 7 );
+    EXPECT( ! ps.has_payload() );
+    EXPECT( ps.payload<parse_position>() == nullptr );
+}
+
+CASE( "payload_status: Stores a small payload inline without heap allocation" )
+{
+    std::size_t const allocations = payload_status::heap_allocations();
+
+    parse_position const pos = { 3, 14 };
+    payload_status ps( 7, pos );
+
+    EXPECT( payload_status::fits_inline<parse_position>::value );
+    EXPECT( ps.payload_is_inline() );
+    EXPECT( ps.payload<parse_position>()->column == 14 );
+    EXPECT( payload_status::heap_allocations() == allocations );
+}
+
+CASE( "payload_status: Stores an oversized payload on the heap" )
+{
+    std::size_t const allocations   = payload_status::heap_allocations();
+    std::size_t const deallocations = payload_status::heap_deallocations();
+    {
+        remote_error const error = { 42, "example.org" };
+        payload_status ps( 7, error );
+
+        EXPECT( !payload_status::fits_inline<remote_error>::value );
+        EXPECT( !ps.payload_is_inline() );
+        EXPECT( ps.payload<remote_error>()->code == 42 );
+        EXPECT( payload_status::heap_allocations() == allocations + 1 );
+    }
+    EXPECT( payload_status::heap_deallocations() == deallocations + 1 );
+}
+
+CASE( "payload_status: Copies, moves and destroys the payload via its type-erased operations" )
+{
+    instance_counter::instances = 0;
+    {
+        payload_status ps1( 7, instance_counter() );
+        payload_status ps2( ps1 );
+
+        EXPECT( instance_counter::instances == 2 );
+
+        payload_status ps3( std::move( ps1 ) );
+
+        EXPECT( ! ps1.has_payload() );
+        EXPECT( ps3.holds<instance_counter>() );
+        EXPECT( instance_counter::instances == 2 );
+
+        ps2 = payload_status( 8 );
+
+        EXPECT( ps2.code() == 8 );
+        EXPECT( instance_counter::instances == 1 );
+    }
+    EXPECT( instance_counter::instances == 0 );
+}
+
+CASE( "payload_status: Yields no payload for a different payload type" )
+{
+    parse_position const pos = { 3, 14 };
+    payload_status ps( 7, pos );
+
+    EXPECT(  ps.holds<parse_position>() );
+    EXPECT( !ps.holds<int>() );
+    EXPECT(  ps.payload<int>() == nullptr );
+}
+
+CASE( "payload_status: Allows use as status of status_value" )
+{
+    parse_position const pos = { 3, 14 };
+    status_value<payload_status, int> sv( payload_status( 7, pos ) );
+
+    EXPECT( !sv );
+    EXPECT( sv.status().code() == 7 );
+    EXPECT( sv.status().payload<parse_position>()->line == 3 );
+}
+
+// -----------------------------------------------------------------------
+// status_message_table<>
+
+#if nsstsv_HAVE_STRING_VIEW
+
+enum class parse_errc { ok, empty_input, bad_digit, overflow };
+
+constexpr status_message_entry<parse_errc> parse_errc_entries[] =
+{
+    { parse_errc::ok         , "ok"          },
+    { parse_errc::empty_input, "empty input" },
+    { parse_errc::bad_digit  , "bad digit"   },
+    { parse_errc::overflow   , "overflow"    },
+};
+
+constexpr auto parse_errc_messages = make_status_message_table( parse_errc_entries );
+
+constexpr status_message_entry<int> http_entries[] =
+{
+    { 200, "OK"                    },
+    { 404, "Not Found"             },
+    { 418, "I'm a teapot"          },
+    { 500, "Internal Server Error" },
+    { 503, "Service Unavailable"   },
+    { -1 , "Unknown"               },
+};
+
+constexpr auto http_messages = make_status_message_table( http_entries );
+
+// 200 sparse codes, the sum of a square and a multiple of a large prime:
+
+struct sparse_code_entries
+{
+    status_message_entry<long long> entries[200];
+
+    constexpr sparse_code_entries() noexcept
+    : entries{}
+    {
+        for ( long long i = 0; i < 200; ++i )
+        {
+            entries[i] = { i * i * 7919 - 100000 + i * 1000003, "code" };
+        }
+    }
+};
+
+constexpr sparse_code_entries sparse_entries;
+constexpr auto sparse_messages = make_status_message_table( sparse_entries.entries );
+
+constexpr bool finds_all_sparse_codes() noexcept
+{
+    for ( auto const & entry : sparse_entries.entries )
+    {
+        if ( sparse_messages.find( entry.code ) != &entry - sparse_entries.entries + sparse_messages.begin() )
+            return false;
+    }
+    return true;
+}
+
+#endif // nsstsv_HAVE_STRING_VIEW
+
+CASE( "status_message_table<>: Yields the message of a code at compile time (dense codes)" )
+{
+#if nsstsv_HAVE_STRING_VIEW
+    static_assert( parse_errc_messages.is_dense(), "expect direct lookup" );
+    static_assert( parse_errc_messages.message( parse_errc::bad_digit ) == "bad digit", "compile-time lookup" );
+
+    status_value<parse_errc, int> sv( parse_errc::overflow );
+
+    EXPECT( parse_errc_messages.message( sv.status() ) == "overflow" );
+    EXPECT( parse_errc_messages.size() == 4u );
+#else
+    EXPECT( !!"status_message_table is not available (no C++17)" );
+#endif
+}
+
+CASE( "status_message_table<>: Yields the message of a code at compile time (sparse codes)" )
+{
+#if nsstsv_HAVE_STRING_VIEW
+    static_assert( ! http_messages.is_dense(), "expect hashed lookup" );
+    static_assert( http_messages.message( 418 ) == "I'm a teapot", "compile-time lookup" );
+
+    for ( auto const & entry : http_entries )
+    {
+        EXPECT( http_messages.message( entry.code ) == entry.message );
+    }
+#else
+    EXPECT( !!"status_message_table is not available (no C++17)" );
+#endif
+}
+
+CASE( "status_message_table<>: Finds each of many sparse codes via a perfect hash" )
+{
+#if nsstsv_HAVE_STRING_VIEW
+    static_assert( ! sparse_messages.is_dense(), "expect hashed lookup" );
+    static_assert( finds_all_sparse_codes(), "compile-time lookup of every code" );
+
+    for ( auto const & entry : sparse_entries.entries )
+    {
+        EXPECT( sparse_messages.contains( entry.code ) );
+        EXPECT( !sparse_messages.contains( entry.code + 1 ) );
+    }
+#else
+    EXPECT( !!"status_message_table is not available (no C++17)" );
+#endif
+}
+
+CASE( "status_message_table<>: Throws on a duplicate code when built at run time" )
+{
+#if nsstsv_HAVE_STRING_VIEW && ! nsstsv_CONFIG_NO_EXCEPTIONS
+    status_message_entry<int> dense[] = { { 1, "one" }, { 2, "two" }, { 1, "uno" } };
+    status_message_entry<int> sparse[] = { { 1, "one" }, { 1000000, "million" }, { 1, "uno" } };
+
+    EXPECT_THROWS_AS( make_status_message_table( dense  ), std::logic_error );
+    EXPECT_THROWS_AS( make_status_message_table( sparse ), std::logic_error );
+#else
+    EXPECT( !!"status_message_table is not available (no C++17), or exceptions are not available" );
+#endif
+}
+
+CASE( "status_message_table<>: Yields an empty message for an unknown code" )
+{
+#if nsstsv_HAVE_STRING_VIEW
+    EXPECT( http_messages.message( 201 ).empty() );
+    EXPECT( !http_messages.contains( 201 ) );
+    EXPECT( parse_errc_messages.message( static_cast<parse_errc>( 17 ) ).empty() );
+#else
+    EXPECT( !!"status_message_table is not available (no C++17)" );
+#endif
+}
+
+CASE( "status_message_table<>: Yields the code of a message (reverse lookup)" )
+{
+#if nsstsv_HAVE_STRING_VIEW
+    static_assert( parse_errc_messages.find( "empty input" )->code == parse_errc::empty_input, "compile-time reverse lookup" );
+
+    EXPECT( http_messages.find( std::string_view( "Not Found" ) )->code == 404 );
+    EXPECT( http_messages.find( std::string_view( "Not found" ) ) == nullptr );
+#else
+    EXPECT( !!"status_message_table is not available (no C++17)" );
+#endif
+}
+
+// -----------------------------------------------------------------------
+// accumulated_status<>
+
+CASE( "accumulated_status<>: Is ok when no failure is accumulated" )
+{
+    accumulated_status<int, 4> as;
+
+    EXPECT( as.ok() );
+    EXPECT( as.size() == 0u );
+    EXPECT( as.is_inline() );
+    EXPECT( as.capacity() == (accumulated_status<int, 4>::inline_capacity) );
+}
+
+CASE( "accumulated_status<>: Stores up to N failures inline" )
+{
+    accumulated_status<std::string, 2> as( "first" );
+    as.push_back( "second" );
+
+    EXPECT( !as.ok() );
+    EXPECT( as.is_inline() );
+    EXPECT( as.size() == 2u );
+    EXPECT( as.front() == "first" );
+    EXPECT( as.back()  == "second" );
+}
+
+CASE( "accumulated_status<>: Spills failures beyond N to the heap" )
+{
+    accumulated_status<std::string, 2> as;
+
+    for ( int i = 0; i < 5; ++i )
+    {
+        as.emplace_back( 1u, char( 'a' + i ) );
+    }
+
+    EXPECT( !as.is_inline() );
+    EXPECT( as.size() == 5u );
+    EXPECT( as.capacity() >= 5u );
+    EXPECT( as[0] == "a" );
+    EXPECT( as[4] == "e" );
+}
+
+CASE( "accumulated_status<>: Allows to append one of its own failures when full" )
+{
+    accumulated_status<std::string, 1> as( "first" );
+
+    as.push_back( as[0] );
+
+    EXPECT( as.size() == 2u );
+    EXPECT( as[1] == "first" );
+}
+
+namespace {
+
+// over-aligned failure that throws on a negative code:
+
+struct alignas( 64 ) aligned_failure
+{
+    int code;
+
+    aligned_failure( int code_ ) : code( code_ )
+    {
+        if ( code < 0 )
+            throw std::invalid_argument( "aligned_failure" );
+    }
+};
+
+bool is_aligned_64( void const * p )
+{
+    return reinterpret_cast<std::uintptr_t>( p ) % 64 == 0;
+}
+
+} // anonymous namespace
+
+CASE( "accumulated_status<>: Spills an over-aligned failure to aligned storage and releases it if growing throws" )
+{
+    accumulated_status<aligned_failure, 1> as;
+
+    as.emplace_back( 1 );
+    as.emplace_back( 2 );
+
+    EXPECT( !as.is_inline() );
+    EXPECT( is_aligned_64( &as[1] ) );
+    EXPECT_THROWS_AS( as.emplace_back( -1 ), std::invalid_argument );
+    EXPECT( as.size() == 2u );
+
+    as.emplace_back( 3 );
+    as.emplace_back( 4 );
+    EXPECT_THROWS_AS( as.emplace_back( -1 ), std::invalid_argument );
+
+    EXPECT( as.size() == 4u );
+    EXPECT( as[3].code == 4 );
+    EXPECT( is_aligned_64( &as[0] ) );
+}
+
+CASE( "accumulated_status<>: Allows copy-construction and move-construction" )
+{
+    SETUP("") {
+    SECTION("inline failures")
+    {
+        accumulated_status<std::string, 2> as1( "first" );
+        accumulated_status<std::string, 2> as2( as1 );
+        accumulated_status<std::string, 2> as3( std::move( as1 ) );
+
+        EXPECT( as1.ok() );
+        EXPECT( as2 == as3 );
+        EXPECT( as3[0] == "first" );
+    }
+    SECTION("spilled failures")
+    {
+        accumulated_status<std::string, 1> as1( "first" );
+        as1.push_back( "second" );
+
+        std::string const * data = &as1[0];
+
+        accumulated_status<std::string, 1> as2( as1 );
+        accumulated_status<std::string, 1> as3( std::move( as1 ) );
+
+        EXPECT( as1.ok() );
+        EXPECT( as1.is_inline() );
+        EXPECT( as2 == as3 );
+        EXPECT( &as3[0] == data );
+    }}
+}
+
+CASE( "append_failure(): Appends a failure and keeps the partial value" )
+{
+    typedef status_value< accumulated_status<std::string, 4>, int > result;
+
+    result sv1( accumulated_status<std::string, 4>(), 42 );
+    result sv2 = append_failure( std::move( sv1 ), "too large" );
+    result sv3 = append_failure( std::move( sv2 ), "odd" );
+
+    EXPECT( sv3.status().size() == 2u );
+    EXPECT( sv3.status()[1] == "odd" );
+    EXPECT( sv3.value() == 42 );
+}
+
+CASE( "append_failure(): Appends a failure and drops the partial value" )
+{
+    typedef status_value< accumulated_status<std::string, 4>, int > result;
+
+    result sv1( accumulated_status<std::string, 4>(), 42 );
+    result sv2 = append_failure( std::move( sv1 ), "too large", partial_value::drop );
+
+    EXPECT( !sv2 );
+    EXPECT( sv2.status()[0] == "too large" );
+}
+
+CASE( "append_failure(): Appends a failure to a status-only result" )
+{
+    typedef status_value< accumulated_status<std::string, 4>, void > result;
+
+    result sv1( accumulated_status<std::string, 4>(), engaged );
+    result sv2 = append_failure( std::move( sv1 ), "too large" );
+
+    EXPECT( !sv2 );
+    EXPECT( sv2.status()[0] == "too large" );
+}
+
+// -----------------------------------------------------------------------
+// context_status<>
+
+CASE( "context_status<>: Allows to push static context frames" )
+{
+    context_status<int> cs( 7 );
+
+    cs.push_context( "while parsing field x" );
+    cs.push_context( "in file y" );
+
+    EXPECT( cs.status() == 7 );
+    EXPECT( cs.depth() == 2u );
+    EXPECT( cs.frame( 0 ).data() == std::string( "while parsing field x" ) );
+}
+
+CASE( "context_status<>: Copies context text into the frame, truncated to fit" )
+{
+    std::string const text( context_frame::text_capacity + 10, 'x' );
+    context_status<int> cs( 7 );
+    {
+        std::string const field = "field " + std::to_string( 42 );
+        cs.push_context_copy( field.c_str() );
+        cs.push_context_copy( text.c_str(), text.size() );
+    }
+
+    EXPECT( std::string( cs.frame( 0 ).data(), cs.frame( 0 ).size() ) == "field 42" );
+    EXPECT( cs.frame( 1 ).size() == (context_frame::text_capacity) );
+}
+
+CASE( "context_status<>: Keeps the innermost and outermost frames and counts the frames between" )
+{
+    context_status<int, 2> cs( 7 );
+
+    cs.push_context( "one" );
+    cs.push_context( "two" );
+    cs.push_context( "three" );
+
+    EXPECT( cs.depth()   == 2u );
+    EXPECT( cs.dropped() == 1u );
+    EXPECT( cs.frame( 0 ).data() == std::string( "one" ) );
+    EXPECT( cs.frame( 1 ).data() == std::string( "three" ) );
+}
+
+CASE( "context_status<>: Renders the count of the dropped frames between the kept ones" )
+{
+    context_status<std::string, 4> cs( "bad digit" );
+
+    char const * const layers[] = { "f1", "f2", "f3", "f4", "f5", "f6" };
+
+    for ( char const * layer : layers )
+        cs.push_context( layer );
+
+    std::ostringstream os;
+    os << cs;
+
+    EXPECT( os.str() == "f6: f5: (2 more): f2: f1: bad digit" );
+}
+
+CASE( "context_status<>: Renders the context outermost first on output" )
+{
+    context_status<std::string> cs( "bad digit" );
+
+    cs.push_context( "while parsing field x" );
+    cs.push_context( "in file y" );
+
+    std::ostringstream os;
+    os << cs;
+
+    EXPECT( os.str() == "in file y: while parsing field x: bad digit" );
+}
+
+CASE( "context_status<>: Renders the context to a wide stream" )
+{
+    context_status<int> cs( 42 );
+
+    cs.push_context( "while parsing field x" );
+    cs.push_context_copy( "in file y" );
+
+    std::wostringstream os;
+    os << cs;
+
+    EXPECT( os.str() == L"in file y: while parsing field x: 42" );
+}
+
+CASE( "with_context(): Adds context to the status of a failure" )
+{
+    typedef status_value< context_status<std::string>, int > result;
+
+    result sv1( std::string( "bad digit" ) );
+    result sv2 = with_context( std::move( sv1 ), "while parsing field x" );
+    result sv3 = with_context_copy( std::move( sv2 ), "in file y", 9 );
+
+    std::ostringstream os;
+    os << sv3.status();
+
+    EXPECT( os.str() == "in file y: while parsing field x: bad digit" );
+}
+
+CASE( "with_context(): Leaves the status and value of a success unchanged" )
+{
+    typedef status_value< context_status<std::string>, int > result;
+
+    result sv1( std::string( "ok" ), 42 );
+    result sv2 = with_context( std::move( sv1 ), "while parsing field x" );
+
+    EXPECT( *sv2 == 42 );
+    EXPECT( sv2.status().depth() == 0u );
+}
+
+// -----------------------------------------------------------------------
+// status_value<S, boxed_value<V, Pool>>
+
+struct document_header
+{
+    int version;
+    char data[2048];
+
+    document_header( int version_ ) : version( version_ ), data() {}
+};
+
+CASE( "status_value<S, boxed_value<V>>: Holds only a pointer to the value" )
+{
+    typedef status_value< int, boxed_value<document_header> > result;
+
+    EXPECT( sizeof( result ) < sizeof( document_header ) );
+    EXPECT( sizeof( result ) <= 3 * sizeof( void * ) );
+}
+
+CASE( "status_value<S, boxed_value<V>>: Allows to observe its value" )
+{
+    status_value< int, boxed_value<document_header> > sv( 7, document_header( 42 ) );
+
+    EXPECT( sv.status() == 7 );
+    EXPECT( sv.value().version == 42 );
+    EXPECT( (*sv).version == 42 );
+    EXPECT( sv->version == 42 );
+}
+
+CASE( "status_value<S, boxed_value<V>>: Moves by transferring the pointer" )
+{
+    status_value< int, boxed_value<document_header> > sv1( 7, document_header( 42 ) );
+    document_header const * value = &*sv1;
+
+    status_value< int, boxed_value<document_header> > sv2( std::move( sv1 ) );
+
+    EXPECT( !sv1 );
+    EXPECT( &*sv2 == value );
+}
+
+CASE( "status_value<S, boxed_value<V>>: Throws when observing non-engaged" )
+{
+#if ! nsstsv_CONFIG_NO_EXCEPTIONS
+    status_value< int, boxed_value<document_header> > sv( 7 );
+
+    EXPECT_THROWS_AS( sv.value(), bad_status_value_access<int> );
+    EXPECT_THROWS_AS( sv->version, bad_status_value_access<int> );
+#else
+    EXPECT( !!"status_value: exceptions not available (nsstsv_CONFIG_NO_EXCEPTIONS)" );
+#endif
+}
+
+CASE( "status_value<S, boxed_value<V>>: Reuses released values with freelist_box_pool" )
+{
+    typedef status_value< int, boxed_value<document_header, freelist_box_pool> > result;
+
+    document_header const * first = nullptr;
+    {
+        result sv( 7, document_header( 1 ) );
+        first = &*sv;
+    }
+    result sv( 7, document_header( 2 ) );
+
+    EXPECT( &*sv == first );
+}
+
+CASE( "status_value<S, boxed_value<V>>: Allocates values from the arena in scope" )
+{
+    typedef status_value< int, boxed_value<document_header, arena_box_pool> > result;
+
+    alignas( document_header ) static char buffer[ 3 * sizeof( arena_box_pool<document_header>::block_type ) ];
+    box_arena arena( buffer, sizeof( buffer ) );
+    {
+        box_arena_scope scope( arena );
+
+        result sv1( 7, document_header( 1 ) );
+        result sv2( 7, document_header( 2 ) );
+
+        EXPECT( arena.owns( &*sv1 ) );
+        EXPECT( arena.owns( &*sv2 ) );
+        EXPECT( box_arena::current() == &arena );
+    }
+    EXPECT( box_arena::current() == nullptr );
+
+    result sv3( 7, document_header( 3 ) );
+
+    EXPECT( !arena.owns( &*sv3 ) );
+    EXPECT( arena.used() == 2 * sizeof( arena_box_pool<document_header>::block_type ) );
+}
+
+CASE( "box_arena: Falls back to the heap when exhausted" )
+{
+    typedef status_value< int, boxed_value<document_header, arena_box_pool> > result;
+
+    alignas( document_header ) static char buffer[ sizeof( arena_box_pool<document_header>::block_type ) ];
+    box_arena arena( buffer, sizeof( buffer ) );
+    box_arena_scope scope( arena );
+
+    result sv1( 7, document_header( 1 ) );
+    result sv2( 7, document_header( 2 ) );
+
+    EXPECT(  arena.owns( &*sv1 ) );
+    EXPECT( !arena.owns( &*sv2 ) );
+}
+
+CASE( "box_arena: Nests scopes on the same arena" )
+{
+    typedef status_value< int, boxed_value<document_header, arena_box_pool> > result;
+
+    alignas( document_header ) static char buffer[ 2 * sizeof( arena_box_pool<document_header>::block_type ) ];
+    box_arena arena( buffer, sizeof( buffer ) );
+    {
+        box_arena_scope outer( arena );
+        {
+            box_arena_scope inner( arena );
+
+            result sv( 7, document_header( 1 ) );
+
+            EXPECT( arena.owns( &*sv ) );
+        }
+        EXPECT( box_arena::current() == &arena );
+    }
+    EXPECT( box_arena::current() == nullptr );
+}
+
+CASE( "box_arena: Releases a value from the arena that outlives its scope" )
+{
+    typedef status_value< int, boxed_value<document_header, arena_box_pool> > result;
+
+    alignas( document_header ) static char buffer[ sizeof( arena_box_pool<document_header>::block_type ) ];
+    box_arena arena( buffer, sizeof( buffer ) );
+
+    std::unique_ptr<result> sv;
+    {
+        box_arena_scope scope( arena );
+
+        sv.reset( new result( 7, document_header( 1 ) ) );
+    }
+    EXPECT( arena.owns( &**sv ) );
+
+    sv.reset();   // must not reach operator delete
+
+    EXPECT( box_arena::current() == nullptr );
+}
+
+CASE( "box_arena: Releases a value from the arena on another thread" )
+{
+    typedef status_value< int, boxed_value<document_header, arena_box_pool> > result;
+
+    alignas( document_header ) static char buffer[ 2 * sizeof( arena_box_pool<document_header>::block_type ) ];
+    box_arena arena( buffer, sizeof( buffer ) );
+
+    std::unique_ptr<result> sv1;
+    std::unique_ptr<result> sv2;
+    {
+        box_arena_scope scope( arena );
+
+        sv1.reset( new result( 7, document_header( 1 ) ) );
+        sv2.reset( new result( 7, document_header( 2 ) ) );
+    }
+    std::unique_ptr<result> sv3( new result( 7, document_header( 3 ) ) );
+
+    EXPECT(  arena.owns( &**sv1 ) );
+    EXPECT( !arena.owns( &**sv3 ) );
+
+    std::thread( [&]() { sv1.reset(); sv3.reset(); } ).join();   // must not reach operator delete for sv1
+
+    EXPECT( arena.owns( &**sv2 ) );
+    EXPECT( arena.used() == 2 * sizeof( arena_box_pool<document_header>::block_type ) );
+}
+
+struct alignas( 64 ) cache_line_header
+{
+    int version;
+
+    cache_line_header( int version_ ) : version( version_ ) {}
+};
+
+CASE( "status_value<S, boxed_value<V>>: Honours the alignment of an over-aligned value" )
+{
+    typedef status_value< int, boxed_value<cache_line_header> > heap_result;
+    typedef status_value< int, boxed_value<cache_line_header, freelist_box_pool> > freelist_result;
+
+    heap_result     sv1( 7, cache_line_header( 1 ) );
+    freelist_result sv2( 7, cache_line_header( 2 ) );
+
+    EXPECT( reinterpret_cast<std::uintptr_t>( &*sv1 ) % 64 == 0u );
+    EXPECT( reinterpret_cast<std::uintptr_t>( &*sv2 ) % 64 == 0u );
+}
+
+// -----------------------------------------------------------------------
+// status_value<> allocator-extended construction
+
+template< typename T >
+struct tagged_allocator
+{
+    typedef T value_type;
+
+    int id;
+
+    tagged_allocator( int id_ ) : id( id_ ) {}
+
+    template< typename U >
+    tagged_allocator( tagged_allocator<U> const & other ) : id( other.id ) {}
+
+    T * allocate( std::size_t n ) { return static_cast<T *>( ::operator new( n * sizeof( T ) ) ); }
+    void deallocate( T * p, std::size_t ) { ::operator delete( p ); }
+};
+
+// uses the allocator_arg_t convention:
+
+struct leading_alloc_type
+{
+    typedef tagged_allocator<char> allocator_type;
+
+    int alloc_id;
+
+    leading_alloc_type() : alloc_id( 0 ) {}
+    leading_alloc_type( std::allocator_arg_t, allocator_type const & alloc, leading_alloc_type const & ) : alloc_id( alloc.id ) {}
+};
+
+// uses the trailing allocator convention:
+
+struct trailing_alloc_type
+{
+    typedef tagged_allocator<char> allocator_type;
+
+    int alloc_id;
+
+    trailing_alloc_type() : alloc_id( 0 ) {}
+    trailing_alloc_type( trailing_alloc_type const & other, allocator_type const & alloc ) : alloc_id( alloc.id ) { (void) other; }
+};
+
+CASE( "status_value<>: Allows uses-allocator construction of status and value" )
+{
+    status_value<leading_alloc_type, trailing_alloc_type> sv1( std::allocator_arg, tagged_allocator<char>( 7 ), leading_alloc_type() );
+    status_value<trailing_alloc_type, leading_alloc_type> sv2( std::allocator_arg, tagged_allocator<char>( 7 ), trailing_alloc_type(), leading_alloc_type() );
+
+    EXPECT( sv1.status().alloc_id == 7 );
+    EXPECT( sv2.status().alloc_id == 7 );
+    EXPECT( sv2.value().alloc_id  == 7 );
+}
+
+// counts its constructions:
+
+struct counted_alloc_status
+{
+    typedef tagged_allocator<char> allocator_type;
+
+    static int constructions;
+
+    int code;
+    int alloc_id;
+
+    counted_alloc_status( int code_, allocator_type const & alloc ) : code( code_ ), alloc_id( alloc.id ) { ++constructions; }
+    counted_alloc_status( counted_alloc_status const & other, allocator_type const & alloc ) : code( other.code ), alloc_id( alloc.id ) { ++constructions; }
+    counted_alloc_status( counted_alloc_status const & other ) : code( other.code ), alloc_id( other.alloc_id ) { ++constructions; }
+};
+
+int counted_alloc_status::constructions = 0;
+
+CASE( "status_value<>: Constructs the status once with the allocator from its argument" )
+{
+    counted_alloc_status::constructions = 0;
+
+    status_value<counted_alloc_status, int>  sv1( std::allocator_arg, tagged_allocator<char>( 7 ), 3 );
+    status_value<counted_alloc_status, int>  sv2( std::allocator_arg, tagged_allocator<char>( 7 ), 3, 42 );
+    status_value<counted_alloc_status, void> sv3( std::allocator_arg, tagged_allocator<char>( 7 ), 3 );
+    status_value<counted_alloc_status, void> sv4( std::allocator_arg, tagged_allocator<char>( 7 ), 3, engaged );
+
+    EXPECT( counted_alloc_status::constructions == 4 );
+    EXPECT( sv1.status().alloc_id == 7 );
+    EXPECT( sv2.status().alloc_id == 7 );
+    EXPECT( sv3.status().alloc_id == 7 );
+    EXPECT( sv4.status().alloc_id == 7 );
+    EXPECT( sv4.has_value() );
+}
+
+CASE( "status_value<>: Ignores the allocator for status and value that do not use one" )
+{
+    status_value<int, int> sv( std::allocator_arg, tagged_allocator<char>( 7 ), 1, 42 );
+
+    EXPECT( sv.status() ==  1 );
+    EXPECT( sv.value()  == 42 );
+}
+
+CASE( "status_value<>: Allows allocator-extended move-construction" )
+{
+    status_value<leading_alloc_type, trailing_alloc_type> sv1( std::allocator_arg, tagged_allocator<char>( 7 ), leading_alloc_type(), trailing_alloc_type() );
+    status_value<leading_alloc_type, trailing_alloc_type> sv2( std::allocator_arg, tagged_allocator<char>( 9 ), std::move( sv1 ) );
+
+    EXPECT( !sv1 );
+    EXPECT( sv2.status().alloc_id == 9 );
+    EXPECT( sv2.value().alloc_id  == 9 );
+}
+
+CASE( "status_value<>: Allows uses-allocator construction of a boxed value" )
+{
+    status_value< int, boxed_value<trailing_alloc_type> > sv( std::allocator_arg, tagged_allocator<char>( 7 ), 1, trailing_alloc_type() );
+
+    EXPECT( sv.value().alloc_id == 7 );
+}
+
+CASE( "status_value<>: Uses an allocator if its status or value does" )
+{
+    EXPECT(  (std::uses_allocator< status_value<int, trailing_alloc_type>, tagged_allocator<char> >::value) );
+    EXPECT(  (std::uses_allocator< status_value<leading_alloc_type, int>, tagged_allocator<char> >::value) );
+    EXPECT( !(std::uses_allocator< status_value<int, int>, tagged_allocator<char> >::value) );
+}
+
+CASE( "status_value<>: Keeps std::pmr status and value in the memory resource of a std::pmr container" )
+{
+#if nsstsv_TEST_HAVE_MEMORY_RESOURCE
+    typedef status_value< int, std::pmr::string > result;
+
+    char buffer[ 4096 ];
+    std::pmr::monotonic_buffer_resource arena( buffer, sizeof( buffer ), std::pmr::null_memory_resource() );
+    std::pmr::vector< result > results( &arena );
+
+    for ( int i = 0; i < 8; ++i )
+    {
+        results.emplace_back( i, std::pmr::string( "a value that does not fit the small string buffer" ) );
+    }
+
+    for ( result const & sv : results )
+    {
+        EXPECT( sv.value().get_allocator().resource() == &arena );
+    }
+#else
+    EXPECT( !!"status_value: std::pmr is not available (no C++17)" );
+#endif
+}
+
+// -----------------------------------------------------------------------
+// status_value<S, V&>
+
+CASE( "status_value<S, V&>: Holds a pointer to the referred value" )
+{
+    EXPECT( sizeof( status_value<int, std::string &> ) == 2 * sizeof( void * ) );
+    EXPECT( (std::is_trivially_copyable< status_value<int, std::string &> >::value) );
+}
+
+CASE( "status_value<S, V&>: Allows to observe the referred value without copying it" )
+{
+    std::string text( "hello" );
+    status_value<int, std::string &> sv( 7, text );
+
+    EXPECT( sv.status() == 7 );
+    EXPECT( sv.has_value() );
+    EXPECT( &sv.value() == &text );
+    EXPECT( &*sv == &text );
+    EXPECT( sv->size() == 5u );
+}
+
+CASE( "status_value<S, V&>: Allows to modify the referred value" )
+{
+    std::string text( "hello" );
+    status_value<int, std::string &> const sv( 7, text );
+
+    *sv += " world";
+
+    EXPECT( text == "hello world" );
+}
+
+CASE( "status_value<S, V&>: Rebinds the reference on assignment" )
+{
+    std::string text1( "one" );
+    std::string text2( "two" );
+    status_value<int, std::string &> sv1( 7, text1 );
+    status_value<int, std::string &> sv2( 8, text2 );
+
+    sv1 = sv2;
+
+    EXPECT( sv1.status() == 8 );
+    EXPECT( &*sv1 == &text2 );
+    EXPECT( text1 == "one" );
+}
+
+CASE( "status_value<S, V&>: Allows conversion to a reference to const" )
+{
+    std::string text( "hello" );
+    status_value<int, std::string &> sv1( 7, text );
+    status_value<int, std::string const &> sv2( sv1 );
+
+    EXPECT( &*sv2 == &text );
+}
+
+CASE( "status_value<S, V&>: Throws when observing non-engaged" )
+{
+#if ! nsstsv_CONFIG_NO_EXCEPTIONS
+    status_value<int, std::string &> sv( 7 );
+
+    EXPECT( !sv );
+    EXPECT_THROWS_AS( sv.value(), bad_status_value_access<int> );
+    EXPECT_THROWS_AS( *sv, bad_status_value_access<int> );
+    EXPECT_THROWS_AS( sv->size(), bad_status_value_access<int> );
+#else
+    EXPECT( !!"status_value: exceptions not available (nsstsv_CONFIG_NO_EXCEPTIONS)" );
+#endif
+}
+
+// -----------------------------------------------------------------------
+// status_value<S, void>
+
+enum class device_errc { ok, busy, offline };
+
+namespace nonstd {
+
+template<>
+struct status_success_traits< device_errc >
+{
+    static constexpr bool is_success( device_errc e ) noexcept { return e == device_errc::ok; }
+};
+
+template<>
+struct status_success_traits< boxed_status<error_details> > : member_ok_success< boxed_status<error_details> > {};
+
+} // namespace nonstd
+
+CASE( "status_value<S, void>: Holds status and engagement" )
+{
+    status_value<int, void> sv1( 7 );
+    status_value<int, void> sv2( 0, engaged );
+
+    EXPECT( !sv1 );
+    EXPECT(  sv2 );
+    EXPECT( sv1.status() == 7 );
+    EXPECT( sv2.status() == 0 );
+    EXPECT( sizeof( status_value<int, void> ) == 2 * sizeof( int ) );
+    EXPECT( (std::is_trivially_copyable< status_value<int, void> >::value) );
+}
+
+CASE( "status_value<S, void>: Holds only the status when S has a success predicate" )
+{
+    status_value<device_errc, void> sv1( device_errc::busy );
+    status_value<device_errc, void> sv2( device_errc::ok );
+
+    EXPECT( !sv1 );
+    EXPECT(  sv2 );
+    EXPECT( sv1.status() == device_errc::busy );
+    EXPECT( sizeof( status_value<device_errc, void> ) == sizeof( device_errc ) );
+}
+
+CASE( "status_value<S, void>: Uses member ok() of a status that opts in as success predicate" )
+{
+    status_value<boxed_status<error_details>, void> sv1( boxed_status<error_details>::make( 42 ) );
+    status_value<boxed_status<error_details>, void> sv2{ boxed_status<error_details>() };
+
+    EXPECT( !sv1 );
+    EXPECT(  sv2 );
+    EXPECT( sizeof( status_value<boxed_status<error_details>, void> ) == sizeof( void * ) );
+}
+
+CASE( "status_value<S, void>: Holds the engagement of a status with member ok() that does not opt in" )
+{
+    typedef status_value< accumulated_status<std::string, 4>, void > result;
+
+    result sv1{ accumulated_status<std::string, 4>() };
+    result sv2( accumulated_status<std::string, 4>(), engaged );
+
+    EXPECT( !sv1 );
+    EXPECT(  sv2 );
+}
+
+CASE( "status_value<S, void>: Observes the engagement in constant expressions" )
+{
+    static_assert( noexcept( std::declval< status_value<int, void> const & >().has_value() ), "noexcept" );
+    static_assert( noexcept( std::declval< status_value<device_errc, void> const & >().has_value() ), "noexcept with a noexcept predicate" );
+    static_assert( noexcept( std::declval< status_value<boxed_status<error_details>, void> const & >().has_value() ), "noexcept with a noexcept member ok()" );
+#if nsstsv_CPP14_000
+    static_assert( ! status_value<int, void>( 7 ), "failure" );
+    static_assert(   status_value<int, void>( 0, engaged ).has_value(), "success" );
+    static_assert( ! status_value<device_errc, void>( device_errc::busy ).has_value(), "failure via the success predicate" );
+    static_assert(   status_value<device_errc, void>( device_errc::ok ), "success via the success predicate" );
+#endif
+    EXPECT( (status_value<device_errc, void>( device_errc::ok ).has_value()) );
+}
+
+CASE( "status_value<S, void>: Allows copy-construction and copy-assignment" )
+{
+    status_value<int, void> sv1( 0, engaged );
+    status_value<int, void> sv2( sv1 );
+    status_value<int, void> sv3( 7 );
+
+    sv3 = sv2;
+
+    EXPECT( sv2 );
+    EXPECT( sv3 );
+    EXPECT( sv3.status() == 0 );
+}
+
+CASE( "status_value<S, void>: Throws when checking the value of a failure" )
+{
+#if ! nsstsv_CONFIG_NO_EXCEPTIONS
+    status_value<int, void> sv1( 7 );
+    status_value<int, void> sv2( 0, engaged );
+
+    status_value<int, void> const sv3( 7 );
+
+    EXPECT_THROWS_AS( sv1.value(), bad_status_value_access<int> );
+    EXPECT_THROWS_AS( sv3.value(), bad_status_value_access<int> );
+    EXPECT_NO_THROW(  sv2.value() );
+#else
+    EXPECT( !!"status_value: exceptions not available (nsstsv_CONFIG_NO_EXCEPTIONS)" );
+#endif
+}
+
+// -----------------------------------------------------------------------
+// status_value<> from_invoke, make_status_value_with()
+
+struct copy_move_counter
+{
+    static int copies;
+    static int moves;
+
+    int value;
+
+    copy_move_counter( int value_ ) : value( value_ ) {}
+    copy_move_counter( copy_move_counter const & other ) : value( other.value ) { ++copies; }
+    copy_move_counter( copy_move_counter && other ) : value( other.value ) { ++moves; }
+
+    static void reset() { copies = moves = 0; }
+};
+
+int copy_move_counter::copies = 0;
+int copy_move_counter::moves  = 0;
+
+copy_move_counter make_counter( int value )
+{
+    return copy_move_counter( value );
+}
+
+CASE( "status_value<>: Allows construction of the value from the result of a callable" )
+{
+    status_value<int, std::string> sv( 7, from_invoke, []( std::size_t n, char c ) { return std::string( n, c ); }, 3u, 'x' );
+
+    EXPECT( sv.status() == 7 );
+    EXPECT( sv.value() == "xxx" );
+}
+
+CASE( "status_value<>: Constructs the value from the result of a callable without moving it (C++17)" )
+{
+#if nsstsv_CPP17_OR_GREATER
+    copy_move_counter::reset();
+
+    status_value<int, copy_move_counter> sv( 7, from_invoke, make_counter, 42 );
+
+    EXPECT( sv.value().value == 42 );
+    EXPECT( copy_move_counter::moves  == 0 );
+    EXPECT( copy_move_counter::copies == 0 );
+#else
+    EXPECT( !!"status_value: guaranteed copy elision is not available (no C++17)" );
+#endif
+}
+
+#if nsstsv_CPP17_OR_GREATER
+
+struct pinned
+{
+    int value;
+
+    pinned( int value_ ) : value( value_ ) {}
+    pinned( pinned const & ) = delete;
+    pinned( pinned && ) = delete;
+};
+
+#endif
+
+CASE( "status_value<>: Allows construction of a non-movable value from the result of a callable (C++17)" )
+{
+#if nsstsv_CPP17_OR_GREATER
+    status_value<int, pinned> sv( 7, from_invoke, []{ return pinned( 42 ); } );
+
+    EXPECT( sv.value().value == 42 );
+#else
+    EXPECT( !!"status_value: guaranteed copy elision is not available (no C++17)" );
+#endif
+}
+
+CASE( "status_value<S, boxed_value<V>>: Allows construction of the value from the result of a callable" )
+{
+    status_value< int, boxed_value<document_header> > sv( 7, from_invoke, []{ return document_header( 42 ); } );
+
+    EXPECT( sv.value().version == 42 );
+}
+
+CASE( "make_status_value_with(): Creates a status_value with the value from the result of a callable" )
+{
+    auto sv = make_status_value_with( 7, []( int n ) { return std::string( std::size_t( n ), 'x' ); }, 3 );
+
+    EXPECT( (std::is_same< decltype( sv ), status_value<int, std::string> >::value) );
+    EXPECT( sv.status() == 7 );
+    EXPECT( sv.value() == "xxx" );
+}
+
+// -----------------------------------------------------------------------
+// status_value<> converting constructors
+
+enum class low_errc { ok, eof };
+
+struct high_status
+{
+    int code;
+
+    high_status( low_errc e ) : code( 100 + static_cast<int>( e ) ) {}
+};
+
+struct wrapped_counter
+{
+    copy_move_counter counter;
+
+    wrapped_counter( copy_move_counter const & c ) : counter( c ) {}
+    wrapped_counter( copy_move_counter && c ) : counter( std::move( c ) ) {}
+};
+
+CASE( "status_value<>: Allows converting copy-construction from other status_value" )
+{
+    status_value<low_errc, copy_move_counter> const sv1( low_errc::ok, copy_move_counter( 42 ) );
+
+    copy_move_counter::reset();
+
+    status_value<high_status, wrapped_counter> sv2( sv1 );
+
+    EXPECT( sv1 );
+    EXPECT( sv2 );
+    EXPECT( sv2.status().code == 100 );
+    EXPECT( sv2.value().counter.value == 42 );
+    EXPECT( copy_move_counter::copies == 1 );
+    EXPECT( copy_move_counter::moves  == 0 );
+}
+
+CASE( "status_value<>: Allows converting move-construction from other status_value" )
+{
+    status_value<low_errc, copy_move_counter> sv1( low_errc::ok, copy_move_counter( 42 ) );
+
+    copy_move_counter::reset();
+
+    status_value<high_status, wrapped_counter> sv2( std::move( sv1 ) );
+
+    EXPECT( !sv1 );
+    EXPECT( sv2 );
+    EXPECT( sv2.value().counter.value == 42 );
+    EXPECT( copy_move_counter::copies == 0 );
+    EXPECT( copy_move_counter::moves  == 1 );
+}
+
+CASE( "status_value<>: Allows converting construction from other status_value without value" )
+{
+    status_value<low_errc, copy_move_counter> sv1( low_errc::eof );
+    status_value<high_status, wrapped_counter> sv2( std::move( sv1 ) );
+
+    EXPECT( !sv2 );
+    EXPECT( sv2.status().code == 101 );
+}
+
+CASE( "status_value<>: Allows implicit conversion from other status_value if status and value convert implicitly" )
+{
+    EXPECT(  (std::is_convertible< status_value<int, int>, status_value<long, long> >::value) );
+    EXPECT(  (std::is_convertible< status_value<int, char const *> const &, status_value<int, std::string> >::value) );
+    EXPECT(  (std::is_convertible< status_value<low_errc, copy_move_counter>, status_value<high_status, wrapped_counter> >::value) );
+}
+
+CASE( "status_value<>: Requires explicit conversion from other status_value if a conversion is narrowing" )
+{
+    EXPECT( !(std::is_convertible  < status_value<long, int>, status_value<int, int> >::value) );
+    EXPECT(  (std::is_constructible< status_value<int, int>, status_value<long, int> >::value) );
+    EXPECT( !(std::is_convertible  < status_value<int, double>, status_value<int, float> >::value) );
+    EXPECT(  (std::is_constructible< status_value<int, float>, status_value<int, double> >::value) );
+
+    status_value<long, int> sv1( 7L, 42 );
+    status_value<int, int> sv2( std::move( sv1 ) );
+
+    EXPECT( sv2.status() == 7 );
+    EXPECT( sv2.value() == 42 );
+}
+
+CASE( "status_value<>: Requires explicit conversion from other status_value if a conversion is explicit (C++17)" )
+{
+#if nsstsv_HAVE_STRING_VIEW
+    EXPECT( !(std::is_convertible  < status_value<int, std::string_view>, status_value<int, std::string> >::value) );
+    EXPECT(  (std::is_constructible< status_value<int, std::string>, status_value<int, std::string_view> >::value) );
+
+    status_value<low_errc, std::string_view> sv1( low_errc::ok, "text" );
+    status_value<high_status, std::string> sv2( sv1 );
+
+    EXPECT( sv2.value() == "text" );
+#else
+    EXPECT( !!"status_value: std::string_view is not available (no C++17)" );
+#endif
+}
+
+CASE( "status_value<>: Disallows conversion from other status_value if status or value do not convert" )
+{
+    EXPECT( !(std::is_constructible< status_value<int, std::string>, status_value<int, int> >::value) );
+    EXPECT( !(std::is_constructible< status_value<std::string, int>, status_value<int, int> >::value) );
+}
+
+// -----------------------------------------------------------------------
+// to_optional(), from_optional(), to_expected(), from_expected()
+
+CASE( "to_optional(): Moves the value of a status_value into a std::optional once" )
+{
+#if nsstsv_HAVE_STD_OPTIONAL
+    status_value<int, copy_move_counter> sv( 0, copy_move_counter( 42 ) );
+
+    copy_move_counter::reset();
+
+    std::optional<copy_move_counter> opt = to_optional( std::move( sv ) );
+
+    EXPECT( opt.has_value() );
+    EXPECT( opt->value == 42 );
+    EXPECT( copy_move_counter::moves  == 1 );
+    EXPECT( copy_move_counter::copies == 0 );
+#else
+    EXPECT( !!"status_value: std::optional is not available (no C++17)" );
+#endif
+}
+
+CASE( "to_optional(): Yields nullopt for a status_value without value" )
+{
+#if nsstsv_HAVE_STD_OPTIONAL
+    status_value<int, int> sv( 7 );
+
+    EXPECT( !to_optional( sv ).has_value() );
+    EXPECT( !to_optional( std::move( sv ) ).has_value() );
+#else
+    EXPECT( !!"status_value: std::optional is not available (no C++17)" );
+#endif
+}
+
+CASE( "from_optional(): Moves the value of a std::optional into a status_value once" )
+{
+#if nsstsv_HAVE_STD_OPTIONAL
+    std::optional<copy_move_counter> opt( std::in_place, 42 );
+
+    copy_move_counter::reset();
+
+    status_value<int, copy_move_counter> sv = from_optional( std::move( opt ), 0, 404 );
+
+    EXPECT( sv.status() == 0 );
+    EXPECT( sv.value().value == 42 );
+    EXPECT( copy_move_counter::moves  == 1 );
+    EXPECT( copy_move_counter::copies == 0 );
+#else
+    EXPECT( !!"status_value: std::optional is not available (no C++17)" );
+#endif
+}
+
+CASE( "from_optional(): Yields the given status for nullopt" )
+{
+#if nsstsv_HAVE_STD_OPTIONAL
+    status_value<int, int> sv = from_optional( std::optional<int>(), 0, 404 );
+
+    EXPECT( !sv );
+    EXPECT( sv.status() == 404 );
+#else
+    EXPECT( !!"status_value: std::optional is not available (no C++17)" );
+#endif
+}
+
+CASE( "to_expected(): Moves the value of a status_value into a std::expected once (C++23)" )
+{
+#if nsstsv_HAVE_STD_EXPECTED
+    status_value<int, copy_move_counter> sv( 0, copy_move_counter( 42 ) );
+
+    copy_move_counter::reset();
+
+    std::expected<copy_move_counter, int> exp = to_expected( std::move( sv ) );
+
+    EXPECT( exp.has_value() );
+    EXPECT( exp->value == 42 );
+    EXPECT( copy_move_counter::moves  == 1 );
+    EXPECT( copy_move_counter::copies == 0 );
+#else
+    EXPECT( !!"status_value: std::expected is not available (no C++23)" );
+#endif
+}
+
+CASE( "to_expected(): Maps the status of a status_value without value to the error (C++23)" )
+{
+#if nsstsv_HAVE_STD_EXPECTED
+    status_value<low_errc, int> sv( low_errc::eof );
+
+    std::expected<int, high_status> exp = to_expected( std::move( sv ), []( low_errc e ) { return high_status( e ); } );
+
+    EXPECT( !exp.has_value() );
+    EXPECT( exp.error().code == 101 );
+#else
+    EXPECT( !!"status_value: std::expected is not available (no C++23)" );
+#endif
+}
+
+CASE( "to_expected(): Converts a status-only result into a std::expected<void, E> (C++23)" )
+{
+#if nsstsv_HAVE_STD_EXPECTED
+    std::expected<void, int> exp1 = to_expected( status_value<int, void>( 7 ) );
+    std::expected<void, int> exp2 = to_expected( status_value<int, void>( 0, engaged ) );
+    std::expected<void, high_status> exp3 = to_expected( status_value<low_errc, void>( low_errc::eof ), []( low_errc e ) { return high_status( e ); } );
+
+    EXPECT( !exp1.has_value() );
+    EXPECT( exp1.error() == 7 );
+    EXPECT(  exp2.has_value() );
+    EXPECT( exp3.error().code == 101 );
+#else
+    EXPECT( !!"status_value: std::expected is not available (no C++23)" );
+#endif
+}
+
+CASE( "from_expected(): Moves the value of a std::expected into a status_value once (C++23)" )
+{
+#if nsstsv_HAVE_STD_EXPECTED
+    std::expected<copy_move_counter, int> exp( std::in_place, 42 );
+
+    copy_move_counter::reset();
+
+    status_value<int, copy_move_counter> sv = from_expected( std::move( exp ), 0 );
+
+    EXPECT( sv.value().value == 42 );
+    EXPECT( copy_move_counter::moves  == 1 );
+    EXPECT( copy_move_counter::copies == 0 );
+#else
+    EXPECT( !!"status_value: std::expected is not available (no C++23)" );
+#endif
+}
+
+CASE( "from_expected(): Maps the error of a std::expected to the status (C++23)" )
+{
+#if nsstsv_HAVE_STD_EXPECTED
+    std::expected<int, low_errc> exp( std::unexpect, low_errc::eof );
+
+    status_value<high_status, int> sv = from_expected( std::move( exp ), high_status( low_errc::ok ), []( low_errc e ) { return high_status( e ); } );
+
+    EXPECT( !sv );
+    EXPECT( sv.status().code == 101 );
+#else
+    EXPECT( !!"status_value: std::expected is not available (no C++23)" );
+#endif
+}
+
+// -----------------------------------------------------------------------
+// packed<>
+
+CASE( "packed<>: Orders the elements to minimize padding, below the equivalent std::tuple" )
+{
+    EXPECT( sizeof( packed<char, double, int> ) == 16u );
+    EXPECT( sizeof( packed<char, double, char, int> ) == 16u );
+    EXPECT( sizeof( packed<char, double, char, int> ) < sizeof( std::tuple<char, double, char, int> ) );
+    EXPECT( alignof( packed<char, double, int> ) == alignof( double ) );
+}
+
+CASE( "packed<>: Allows to access the elements by their original index" )
+{
+    packed<char, double, int> p( 'x', 1.5, 42 );
+
+    EXPECT( p.get<0>() == 'x' );
+    EXPECT( p.get<1>() == 1.5 );
+    EXPECT( p.get<2>() == 42 );
+    EXPECT( get<2>( p ) == 42 );
+
+    p.get<2>() = 7;
+
+    EXPECT( get<2>( p ) == 7 );
+    EXPECT( p.get<0>() == 'x' );
+}
+
+CASE( "packed<>: Value-initializes the elements on default construction" )
+{
+    packed<char, double, int> p;
+
+    EXPECT( p.get<0>() == '\0' );
+    EXPECT( p.get<1>() == 0.0 );
+    EXPECT( p.get<2>() == 0 );
+}
+
+CASE( "packed<>: Allows to move an element out of an rvalue packed" )
+{
+    packed<std::unique_ptr<int>, char> p( std::unique_ptr<int>( new int( 42 ) ), 'x' );
+
+    std::unique_ptr<int> q = get<0>( std::move( p ) );
+
+    EXPECT( *q == 42 );
+    EXPECT( p.get<0>() == nullptr );
+}
+
+CASE( "packed<>: Allows to deduce the element types with make_packed()" )
+{
+    std::string const text( "abc" );
+
+    auto p = make_packed( text, std::size_t( 3 ), true );
+
+    EXPECT( p.size() == 3u );
+    EXPECT( (std::is_same< std::tuple_element<0, decltype( p )>::type, std::string >::value) );
+    EXPECT( std::tuple_size<decltype( p )>::value == 3u );
+    EXPECT( p.get<0>() == "abc" );
+    EXPECT( p.get<1>() == 3u );
+    EXPECT( p.get<2>() );
+}
+
+CASE( "packed<>: Supports structured bindings (C++17)" )
+{
+#if nsstsv_CPP17_OR_GREATER
+    packed<char, double, int> p( 'x', 1.5, 42 );
+
+    auto & [c, d, i] = p;
+
+    EXPECT( c == 'x' );
+    EXPECT( d == 1.5 );
+    EXPECT( i == 42 );
+
+    i = 7;
+
+    EXPECT( p.get<2>() == 7 );
+#else
+    EXPECT( !!"packed: structured bindings are not available (no C++17)" );
+#endif
+}
+
+CASE( "packed<>: Allows to return several values from a function via status_value" )
+{
+    struct parse
+    {
+        static status_value< int, packed<std::string, std::size_t, bool> > token( std::string const & text )
+        {
+            std::size_t const end = text.find( ' ' );
+
+            if ( end == 0 )
+                return { 22 };
+
+            return { 0, make_packed( text.substr( 0, end ), end == std::string::npos ? text.size() : end, end == std::string::npos ) };
+        }
+    };
+
+    auto sv = parse::token( "abc def" );
+
+    EXPECT( sv );
+    EXPECT( sv->get<0>() == "abc" );
+    EXPECT( sv->get<1>() == 3u );
+    EXPECT( !sv->get<2>() );
+    EXPECT( !parse::token( " def" ) );
+}
+
+// -----------------------------------------------------------------------
+// status_value_vector<>
+
+CASE( "status_value_vector<>: Allows to append elements with and without value" )
+{
+    status_value_vector<int, std::string> vec;
+
+    vec.push_back( status_value<int, std::string>( 0, "abc" ) );
+    vec.push_back( status_value<int, std::string>( 42 ) );
+    vec.emplace_back( 0, 3u, 'x' );
+    vec.emplace_back( 7 );
+
+    EXPECT( vec.size() == 4u );
+    EXPECT( vec[0].has_value() );
+    EXPECT( vec[0].value() == "abc" );
+    EXPECT( !vec[1] );
+    EXPECT( vec[1].status() == 42 );
+    EXPECT( *vec[2] == "xxx" );
+    EXPECT( vec[2]->size() == 3u );
+    EXPECT( !vec[3].has_value() );
+}
+
+CASE( "status_value_vector<>: Moves the status and value of an rvalue status_value it appends" )
+{
+    status_value_vector<copy_move_counter, copy_move_counter> vec;
+    vec.reserve( 1 );
+
+    status_value<copy_move_counter, copy_move_counter> sv( copy_move_counter( 7 ), copy_move_counter( 42 ) );
+    copy_move_counter::reset();
+
+    vec.push_back( std::move( sv ) );
+
+    EXPECT( copy_move_counter::copies == 0 );
+    EXPECT( vec[0].status().value == 7 );
+    EXPECT( vec[0].value().value == 42 );
+}
+
+CASE( "status_value_vector<>: Throws bad_status_value_access on access of a missing value" )
+{
+    status_value_vector<int, int> vec;
+
+    vec.emplace_back( 42 );
+
+    EXPECT_THROWS_AS( vec[0].value(), bad_status_value_access<int> );
+    EXPECT_THROWS_AS( vec.value( 0 ), bad_status_value_access<int> );
+}
+
+CASE( "status_value_vector<>: Allows to assign an element via its proxy" )
+{
+    status_value_vector<int, std::string> vec;
+
+    vec.emplace_back( 0, "abc" );
+    vec.emplace_back( 42 );
+
+    vec[0] = status_value<int, std::string>( 7 );
+    vec[1] = status_value<int, std::string>( 0, "def" );
+
+    EXPECT( !vec[0] );
+    EXPECT( vec[0].status() == 7 );
+    EXPECT( vec[1].value() == "def" );
+
+    vec[0] = vec[1];
+
+    EXPECT( vec[0].value() == "def" );
+    EXPECT( vec.count_engaged() == 2u );
+}
+
+CASE( "status_value_vector<>: Allows to copy an element out as status_value" )
+{
+    status_value_vector<int, std::string> vec;
+
+    vec.emplace_back( 0, "abc" );
+    vec.emplace_back( 42 );
+
+    status_value<int, std::string> sv0 = vec[0];
+    status_value<int, std::string> sv1 = vec[1];
+
+    EXPECT( sv0.value() == "abc" );
+    EXPECT( !sv1 );
+    EXPECT( sv1.status() == 42 );
+}
+
+CASE( "status_value_vector<>: Counts engaged and failed elements" )
+{
+    status_value_vector<int, int> vec;
+
+    for ( int i = 0; i < 200; ++i )
+    {
+        if ( i % 3 == 0 )
+            vec.emplace_back( 1 );
+        else
+            vec.emplace_back( 0, i );
+    }
+
+    EXPECT( vec.count_failed()  ==  67u );
+    EXPECT( vec.count_engaged() == 133u );
+
+    vec.pop_back();
+    vec.pop_back();
+
+    EXPECT( vec.size() == 198u );
+    EXPECT( vec.count_failed()  ==  66u );
+    EXPECT( vec.count_engaged() == 132u );
+}
+
+CASE( "status_value_vector<>: Keeps values when growing, copying and moving" )
+{
+    status_value_vector<int, std::string> vec;
+
+    for ( int i = 0; i < 100; ++i )
+    {
+        if ( i % 2 )
+            vec.emplace_back( i );
+        else
+            vec.emplace_back( 0, std::to_string( i ) );
+    }
+
+    status_value_vector<int, std::string> copy( vec );
+    status_value_vector<int, std::string> moved( std::move( vec ) );
+
+    EXPECT( vec.empty() );
+    EXPECT( copy.size() == 100u );
+    EXPECT( moved.size() == 100u );
+    EXPECT( copy[98].value() == "98" );
+    EXPECT( moved[98].value() == "98" );
+    EXPECT( copy[99].status() == 99 );
+    EXPECT( moved.count_engaged() == 50u );
+
+    copy.clear();
+
+    EXPECT( copy.empty() );
+    EXPECT( copy.count_engaged() == 0u );
+}
+
+CASE( "status_value_vector<>: Allows to append a copy of its own element when growing" )
+{
+    status_value_vector<int, std::string> vec;
+
+    vec.emplace_back( 1, std::string( 100, 'a' ) );
+
+    while ( vec.size() < vec.capacity() )
+        vec.emplace_back( 2, vec.value( 0 ) );
+
+    vec.emplace_back( vec.status( 0 ), vec.value( 0 ) );
+
+    EXPECT( vec.size() == 9u );
+    EXPECT( vec[ vec.size() - 1 ].value() == std::string( 100, 'a' ) );
+    EXPECT( vec[ vec.size() - 1 ].status() == 1 );
+}
+
+CASE( "status_value_vector<>: Stores values, statuses and engagement in separate arrays" )
+{
+    status_value_vector<int, double> vec;
+
+    vec.emplace_back( 0, 1.5 );
+    vec.emplace_back( 42 );
+    vec.emplace_back( 0, 2.5 );
+
+    EXPECT( vec.values()[0] == 1.5 );
+    EXPECT( vec.values()[2] == 2.5 );
+    EXPECT( vec.statuses()[1] == 42 );
+    EXPECT( vec.engaged_words()[0] == 5u );
+    EXPECT( vec.word_count( vec.size() ) == 1u );
+}
+
+CASE( "status_value_vector<>: Allows to iterate over its elements via proxies" )
+{
+    status_value_vector<int, int> vec;
+
+    vec.emplace_back( 0, 1 );
+    vec.emplace_back( 42 );
+    vec.emplace_back( 0, 3 );
+
+    int sum = 0;
+    for ( auto && element : vec )
+    {
+        if ( element )
+            sum += *element;
+    }
+
+    status_value_vector<int, int>::const_iterator pos = vec.begin();
+
+    EXPECT( sum == 4 );
+    EXPECT( vec.end() - vec.begin() == 3 );
+    EXPECT( pos[1].status() == 42 );
+    EXPECT( ( *( pos + 2 ) ).value() == 3 );
+    EXPECT( std::count_if( vec.cbegin(), vec.cend(), []( status_value<int, int> const & sv ) { return !sv; } ) == 1 );
+
+    vec.pop_back();
+
+    EXPECT( collect( vec ).status() == 42 );
+
+    vec.pop_back();
+    status_value< int, std::vector<int> > values = collect( vec );
+
+    EXPECT( values.value() == std::vector<int>{ 1 } );
+}
+
+// -----------------------------------------------------------------------
+// sparse_status_vector<>
+
+CASE( "sparse_status_vector<>: Stores the values densely and statuses for failures only" )
+{
+    sparse_status_vector<std::string, int> vec( "ok" );
+
+    vec.emplace_value( 1 );
+    vec.push_failure( "not found" );
+    vec.push_back( status_value<std::string, int>( "ok", 3 ) );
+    vec.push_back( status_value<std::string, int>( "timeout" ) );
+
+    EXPECT( vec.size() == 4u );
+    EXPECT( vec.count_engaged() == 2u );
+    EXPECT( vec.count_failed()  == 2u );
+    EXPECT( vec.values().size() == 2u );
+    EXPECT( vec.failures().size() == 2u );
+    EXPECT( vec.failures()[1].index == 3u );
+    EXPECT( vec.failures()[1].status == "timeout" );
+}
+
+CASE( "sparse_status_vector<>: Keeps the status of an engaged element that is not the success status" )
+{
+    sparse_status_vector<std::string, int> vec( "ok" );
+
+    vec.push_back( status_value<std::string, int>( "ok", 1 ) );
+    vec.push_back( status_value<std::string, int>( "partial", 2 ) );
+    vec.push_failure( "timeout" );
+    vec.push_back( status_value<std::string, int>( "ok", 4 ) );
+
+    EXPECT( vec.count_engaged() == 3u );
+    EXPECT( vec.engaged_statuses().size() == 1u );
+    EXPECT( vec.status( 0 ) == "ok" );
+    EXPECT( vec.status( 1 ) == "partial" );
+    EXPECT( vec.status( 3 ) == "ok" );
+    EXPECT( vec[1].status() == "partial" );
+    EXPECT( vec[1].value() == 2 );
+}
+
+CASE( "sparse_status_vector<>: Keeps the status of every engaged element if the status has no operator==" )
+{
+    sparse_status_vector<payload_status, int> vec;
+
+    vec.emplace_value( 1 );
+    vec.push_back( status_value<payload_status, int>( payload_status( 0 ), 2 ) );
+    vec.push_back( status_value<payload_status, int>( payload_status( 3, parse_position{ 3, 14 } ), 3 ) );
+    vec.push_back( status_value<payload_status, int>( payload_status( 7 ) ) );
+
+    EXPECT( vec.count_engaged() == 3u );
+    EXPECT( vec.engaged_statuses().size() == 2u );
+    EXPECT( vec.status( 0 ).code() == 0 );
+    EXPECT( vec.status( 2 ).code() == 3 );
+    EXPECT( vec.status( 2 ).payload<parse_position>()->line == 3 );
+    EXPECT( vec.status( 3 ).code() == 7 );
+    EXPECT( vec.value( 2 ) == 3 );
+}
+
+CASE( "sparse_status_vector<>: Allows to access elements by index" )
+{
+    sparse_status_vector<int, int> vec;
+
+    for ( int i = 0; i < 1000; ++i )
+    {
+        if ( i % 97 == 0 )
+            vec.push_failure( i );
+        else
+            vec.emplace_value( 2 * i );
+    }
+
+    bool all = true;
+
+    for ( int i = 0; i < 1000; ++i )
+    {
+        std::size_t const pos = static_cast<std::size_t>( i );
+
+        if ( i % 97 == 0 )
+            all = all && !vec.has_value( pos ) && vec.status( pos ) == i && !vec[pos];
+        else
+            all = all && vec.has_value( pos ) && vec.status( pos ) == 0 && vec.value( pos ) == 2 * i && vec[pos].value() == 2 * i;
+    }
+
+    EXPECT( all );
+    EXPECT( vec.count_failed() == 11u );
+}
+
+CASE( "sparse_status_vector<>: Throws bad_status_value_access on access of a missing value" )
+{
+    sparse_status_vector<int, int> vec;
+
+    vec.push_failure( 42 );
+
+    EXPECT_THROWS_AS( vec.value( 0 ), bad_status_value_access<int> );
+}
+
+CASE( "sparse_status_vector<>: Needs less memory than a vector of status_value for mostly successes" )
+{
+    std::size_t const n = 10000;
+
+    sparse_status_vector<std::string, int> sparse;
+    std::vector< status_value<std::string, int> > dense;
+
+    sparse.reserve( n, n / 100 );
+    dense.reserve( n );
+
+    for ( std::size_t i = 0; i < n; ++i )
+    {
+        if ( i % 100 == 0 )
+        {
+            sparse.push_failure( "failure" );
+            dense.push_back( status_value<std::string, int>( "failure" ) );
+        }
+        else
+        {
+            sparse.emplace_value( 42 );
+            dense.push_back( status_value<std::string, int>( "ok", 42 ) );
+        }
+    }
+
+    EXPECT( 4 * sparse.allocated_bytes() < dense.capacity() * sizeof( status_value<std::string, int> ) );
+}
+
+// -----------------------------------------------------------------------
+// compact_values()
+
+namespace {
+
+template< typename V >
+status_value_vector<int, V> make_batch( std::size_t n, unsigned failure_rate )
+{
+    status_value_vector<int, V> batch;
+
+    for ( std::size_t i = 0; i < n; ++i )
+    {
+        if ( ( i * 7919u ) % 100u < failure_rate )
+            batch.emplace_back( 1 );
+        else
+            batch.emplace_back( 0, V( i ) );
+    }
+    return batch;
+}
+
+template< typename V >
+bool compacts_all( simd_isa isa )
+{
+    std::size_t const sizes[] = { 0, 1, 63, 64, 65, 200, 1000, 5000 };
+    unsigned const rates[] = { 0, 10, 50, 100 };
+
+    for ( std::size_t n : sizes )
+    {
+        for ( unsigned rate : rates )
+        {
+            status_value_vector<int, V> batch = make_batch<V>( n, rate );
+            std::vector<V> expected;
+            std::vector<V> out( batch.count_engaged() );
+
+            for ( std::size_t i = 0; i < batch.size(); ++i )
+            {
+                if ( batch[i] )
+                    expected.push_back( *batch[i] );
+            }
+
+            if ( compact_values( batch, out.data(), isa ) != expected.size() || out != expected )
+                return false;
+
+            std::vector<V> appended;
+            compact_values( batch, appended );
+
+            if ( appended != expected )
+                return false;
+        }
+    }
+    return true;
+}
+
+struct wide_value
+{
+    double x, y;
+
+    wide_value() : x(), y() {}
+    wide_value( std::size_t i ) : x( double( i ) ), y( -double( i ) ) {}
+
+    friend bool operator==( wide_value const & a, wide_value const & b ) { return a.x == b.x && a.y == b.y; }
+};
+
+} // anonymous namespace
+
+CASE( "compact_values(): Copies the engaged values of a batch in order, scalar" )
+{
+    EXPECT( compacts_all<float       >( simd_isa::scalar ) );
+    EXPECT( compacts_all<double      >( simd_isa::scalar ) );
+    EXPECT( compacts_all<std::int16_t>( simd_isa::scalar ) );
+    EXPECT( compacts_all<wide_value  >( simd_isa::scalar ) );
+}
+
+CASE( "compact_values(): Copies the engaged values of a batch in order, AVX2 if available" )
+{
+    EXPECT( compacts_all<float       >( simd_isa::avx2 ) );
+    EXPECT( compacts_all<double      >( simd_isa::avx2 ) );
+    EXPECT( compacts_all<std::int32_t>( simd_isa::avx2 ) );
+    EXPECT( compacts_all<std::int64_t>( simd_isa::avx2 ) );
+    EXPECT( compacts_all<wide_value  >( simd_isa::avx2 ) );
+}
+
+CASE( "compact_values(): Copies the engaged values of a batch in order, AVX-512 if available" )
+{
+    EXPECT( compacts_all<float       >( simd_isa::avx512 ) );
+    EXPECT( compacts_all<double      >( simd_isa::avx512 ) );
+    EXPECT( compacts_all<std::int32_t>( simd_isa::avx512 ) );
+    EXPECT( compacts_all<std::int64_t>( simd_isa::avx512 ) );
+}
+
+CASE( "compact_values(): Appends the engaged values of a batch to a std::vector" )
+{
+    status_value_vector<int, int> batch;
+
+    batch.emplace_back( 0, 1 );
+    batch.emplace_back( 1 );
+    batch.emplace_back( 0, 3 );
+
+    std::vector<int> out( 1, 42 );
+
+    compact_values( batch, out );
+
+    EXPECT( out.size() == 3u );
+    EXPECT( out[0] == 42 );
+    EXPECT( out[1] ==  1 );
+    EXPECT( out[2] ==  3 );
+}
+
+// -----------------------------------------------------------------------
+// status_histogram()
+
+namespace {
+
+enum class input_errc { ok, invalid_argument, out_of_range, overflow };
+
+template< typename S >
+S status_at( std::size_t i, unsigned failure_rate )
+{
+    return ( i * 7919u ) % 100u < failure_rate ? static_cast<S>( 1 + i % 3 ) : static_cast<S>( 0 );
+}
+
+template< typename S >
+bool counts_all( simd_isa isa )
+{
+    std::size_t const sizes[] = { 0, 1, 7, 8, 17, 100, 1000 };
+    unsigned const rates[] = { 0, 5, 50, 100 };
+
+    for ( std::size_t n : sizes )
+    {
+        for ( unsigned rate : rates )
+        {
+            status_value_vector<S, int> batch;
+            std::size_t expected[4] = { 0, 0, 0, 0 };
+
+            for ( std::size_t i = 0; i < n; ++i )
+            {
+                batch.emplace_back( status_at<S>( i, rate ) );
+                ++expected[ static_cast<std::size_t>( status_at<S>( i, rate ) ) ];
+            }
+
+            status_counts const counts = status_histogram( batch, 3, isa );
+
+            if ( counts.count( S( 0 ) ) != expected[0] || counts.count( S( 1 ) ) != expected[1]
+                || counts.count( S( 2 ) ) != expected[2] || counts.other() != expected[3] || counts.total() != n )
+                return false;
+        }
+    }
+    return true;
+}
+
+} // anonymous namespace
+
+CASE( "status_histogram(): Counts the status codes of a batch, scalar" )
+{
+    EXPECT( counts_all<input_errc   >( simd_isa::scalar ) );
+    EXPECT( counts_all<std::int16_t >( simd_isa::scalar ) );
+}
+
+CASE( "status_histogram(): Counts the status codes of a batch, AVX2 if available" )
+{
+    EXPECT( counts_all<input_errc   >( simd_isa::avx2 ) );
+    EXPECT( counts_all<std::uint32_t>( simd_isa::avx2 ) );
+}
+
+CASE( "status_histogram(): Counts the status codes of a batch, AVX-512 if available" )
+{
+    EXPECT( counts_all<input_errc   >( simd_isa::avx512 ) );
+    EXPECT( counts_all<std::int32_t >( simd_isa::avx512 ) );
+}
+
+CASE( "status_histogram(): Counts codes that span more than the vectorised codes per block, for each instruction set" )
+{
+    simd_isa const isas[] = { simd_isa::scalar, simd_isa::avx2, simd_isa::avx512 };
+
+    status_value_vector<int, int> batch;
+    std::size_t expected_low = 0;
+    std::size_t expected_other = 0;
+
+    for ( std::size_t i = 0; i < 10000; ++i )
+    {
+        int const code = i < 5000 ? static_cast<int>( i % 1000 ) - 20 : static_cast<int>( i % 11 );
+
+        batch.emplace_back( code );
+        expected_low   += code == 3 ? 1 : 0;
+        expected_other += code < 0 || code >= 256 ? 1 : 0;
+    }
+
+    for ( simd_isa isa : isas )
+    {
+        status_counts const counts = status_histogram( batch, 256, isa );
+
+        EXPECT( counts.count( 3 ) == expected_low );
+        EXPECT( counts.other() == expected_other );
+        EXPECT( counts.total() == batch.size() );
+    }
+}
+
+CASE( "status_histogram(): Counts codes outside the bins together" )
+{
+    status_value_vector<int, int> batch;
+
+    batch.emplace_back( -1 );
+    batch.emplace_back( 0, 42 );
+    batch.emplace_back( 300 );
+
+    status_counts const counts = status_histogram( batch );
+
+    EXPECT( counts.bins() == 256u );
+    EXPECT( counts.count( 0 ) == 1u );
+    EXPECT( counts.count( -1 ) == 0u );
+    EXPECT( counts.other() == 2u );
+}
+
+CASE( "status_histogram(): Counts the status codes of a std::vector of status_value" )
+{
+    std::vector< status_value<input_errc, int> > batch;
+
+    batch.push_back( status_value<input_errc, int>( input_errc::ok, 1 ) );
+    batch.push_back( status_value<input_errc, int>( input_errc::out_of_range ) );
+    batch.push_back( status_value<input_errc, int>( input_errc::ok, 3 ) );
+    batch.push_back( status_value<input_errc, int>( input_errc::invalid_argument ) );
+    batch.push_back( status_value<input_errc, int>( input_errc::out_of_range ) );
+
+    status_counts const counts = status_histogram( batch, 4 );
+
+    EXPECT( counts.count( input_errc::ok               ) == 2u );
+    EXPECT( counts.count( input_errc::invalid_argument ) == 1u );
+    EXPECT( counts.count( input_errc::out_of_range     ) == 2u );
+    EXPECT( counts.count( input_errc::overflow         ) == 0u );
+}
+
+CASE( "status_histogram(): Counts the status codes of a sparse_status_vector" )
+{
+    sparse_status_vector<input_errc, int> batch( input_errc::ok );
+
+    batch.emplace_value( 1 );
+    batch.push_failure( input_errc::overflow );
+    batch.emplace_value( 3 );
+    batch.push_back( status_value<input_errc, int>( input_errc::out_of_range, 4 ) );
+
+    status_counts counts = status_histogram( batch, 4 );
+
+    EXPECT( counts.count( input_errc::ok           ) == 2u );
+    EXPECT( counts.count( input_errc::overflow     ) == 1u );
+    EXPECT( counts.count( input_errc::out_of_range ) == 1u );
+
+    counts += status_histogram( batch, 4 );
+
+    EXPECT( counts.count( input_errc::ok ) == 4u );
+    EXPECT( counts.total() == 8u );
+}
+
+// -----------------------------------------------------------------------
+// group_by_status(), partition_by_status()
+
+CASE( "group_by_status(): Groups the indices of a batch by status code, stable" )
+{
+    status_value_vector<input_errc, int> batch;
+
+    batch.emplace_back( input_errc::out_of_range );
+    batch.emplace_back( input_errc::ok, 1 );
+    batch.emplace_back( input_errc::invalid_argument );
+    batch.emplace_back( input_errc::out_of_range );
+    batch.emplace_back( input_errc::ok, 4 );
+
+    status_groups const groups = group_by_status( batch, 4 );
+
+    std::vector<std::size_t> const ok( groups.group( input_errc::ok ).begin(), groups.group( input_errc::ok ).end() );
+    std::vector<std::size_t> const range( groups.group( input_errc::out_of_range ).begin(), groups.group( input_errc::out_of_range ).end() );
+
+    EXPECT( ok    == (std::vector<std::size_t>{ 1, 4 }) );
+    EXPECT( range == (std::vector<std::size_t>{ 0, 3 }) );
+    EXPECT( groups.group( input_errc::invalid_argument ).size() == 1u );
+    EXPECT( groups.group( input_errc::overflow ).empty() );
+    EXPECT( groups.other().empty() );
+    EXPECT( groups.indices().size() == 5u );
+}
+
+CASE( "group_by_status(): Groups codes outside the bins together" )
+{
+    std::vector< status_value<int, int> > batch;
+
+    batch.push_back( status_value<int, int>( 7 ) );
+    batch.push_back( status_value<int, int>( 0, 1 ) );
+    batch.push_back( status_value<int, int>( -1 ) );
+
+    status_groups const groups = group_by_status( batch, 2 );
+
+    EXPECT( groups.bins() == 2u );
+    EXPECT( groups.group( 0 ).size() == 1u );
+    EXPECT( *groups.group( 0 ).begin() == 1u );
+    EXPECT( groups.group( 7 ).empty() );
+    EXPECT( groups.other().size() == 2u );
+    EXPECT( *groups.other().begin() == 0u );
+}
+
+CASE( "partition_by_status(): Reorders a batch by status code, moving each value once" )
+{
+    status_value_vector<int, copy_move_counter> batch;
+
+    for ( int i = 0; i < 100; ++i )
+    {
+        if ( i % 3 )
+            batch.emplace_back( 0, i );
+        else
+            batch.emplace_back( 1 + i % 2 );
+    }
+
+    copy_move_counter::reset();
+
+    status_groups const groups = partition_by_status( batch, 4 );
+
+    EXPECT( copy_move_counter::moves  == 66 );
+    EXPECT( copy_move_counter::copies ==  0 );
+    EXPECT( groups.offsets()[1] == 66u );
+    EXPECT( batch.size() == 100u );
+    EXPECT( batch[0].value().value == 1 );
+    EXPECT( batch[1].value().value == 2 );
+    EXPECT( batch[65].value().value == 98 );
+    EXPECT( batch[66].status() == 1 );
+    EXPECT( batch[99].status() == 2 );
+    EXPECT( groups.indices()[66] == 0u );
+}
+
+// -----------------------------------------------------------------------
+// pipeline<>
+
+namespace {
+
+struct stage_counts
+{
+    int parsed = 0, validated = 0, converted = 0;
+};
+
+} // anonymous namespace
+
+CASE( "pipeline<>: Applies the stages in turn to the value of the previous stage" )
+{
+    auto p = make_pipeline(
+        []( std::string const & text ) { return text.empty() ? status_value<int, int>( 1 ) : status_value<int, int>( 0, std::stoi( text ) ); },
+        []( int x ) { return x < 100 ? status_value<int, int>( 0, x ) : status_value<int, int>( 2 ); },
+        []( int x ) { return status_value<int, double>( 0, x / 2.0 ); } );
+
+    status_value<int, double> sv = p( std::string( "42" ) );
+
+    EXPECT( sv.value() == 21.0 );
+    EXPECT( p( std::string( "" ) ).status() == 1 );
+    EXPECT( p( std::string( "420" ) ).status() == 2 );
+}
+
+CASE( "pipeline<>: Skips the remaining stages on the first failure" )
+{
+    stage_counts counts;
+
+    auto p = make_pipeline(
+        [&]( int x ) { ++counts.parsed;    return status_value<int, int>( 0, x ); },
+        [&]( int x ) { ++counts.validated; return x % 2 ? status_value<int, int>( 7 ) : status_value<int, int>( 0, x ); },
+        [&]( int x ) { ++counts.converted; return status_value<int, int>( 0, 10 * x ); } );
+
+    for ( int i = 0; i < 10; ++i )
+        p( i );
+
+    EXPECT( counts.parsed    == 10 );
+    EXPECT( counts.validated == 10 );
+    EXPECT( counts.converted ==  5 );
+}
+
+CASE( "pipeline<>: Moves the value from stage to stage" )
+{
+    auto p = make_pipeline(
+        []( int x ) { return status_value<int, copy_move_counter>( 0, copy_move_counter( x ) ); },
+        []( copy_move_counter && c ) { return status_value<int, copy_move_counter>( 0, std::move( c ) ); } );
+
+    copy_move_counter::reset();
+
+    status_value<int, copy_move_counter> sv = p( 42 );
+
+    EXPECT( sv.value().value == 42 );
+    EXPECT( copy_move_counter::copies == 0 );
+}
+
+CASE( "pipeline<>: Allows to append stages with then() and operator|" )
+{
+    auto twice = []( int x ) { return status_value<int, int>( 0, 2 * x ); };
+
+    auto const p = make_pipeline( twice ).then( twice ) | twice;
+
+    EXPECT( p( 1 ).value() == 8 );
+}
+
+CASE( "pipeline<>: Allows to run over a batch, materializing only the final results" )
+{
+    auto p = make_pipeline(
+        []( int x ) { return x < 0 ? status_value<int, int>( 1 ) : status_value<int, int>( 0, x ); },
+        []( int x ) { return status_value<int, double>( 0, x + 0.5 ); } );
+
+    std::vector<int> const inputs = { 1, -2, 3 };
+    status_value_vector<int, double> results;
+
+    p.run( inputs, results );
+
+    EXPECT( results.size() == 3u );
+    EXPECT( results[0].value() == 1.5 );
+    EXPECT( results[1].status() == 1 );
+    EXPECT( results[2].value() == 3.5 );
+}
+
+// -----------------------------------------------------------------------
+// collect(), collect_into(), collect_all()
+
+namespace {
+
+typedef status_value<int, copy_move_counter> counted_result;
+
+std::vector<counted_result> make_counted( std::initializer_list<int> codes )
+{
+    std::vector<counted_result> results;
+
+    for ( int code : codes )
+    {
+        if ( code == 0 ) results.emplace_back( 0, copy_move_counter( int( results.size() ) ) );
+        else             results.emplace_back( code );
+    }
+    return results;
+}
+
+// Non-owning view of elements, like a span:
+
+template< typename T >
+struct element_span
+{
+    T * first;
+    T * last;
+
+    T * begin() const { return first; }
+    T * end() const { return last; }
+    std::size_t size() const { return static_cast<std::size_t>( last - first ); }
+};
+
+struct reserve_recorder
+{
+    std::vector<int> values;
+    std::size_t reserved = 0;
+
+    std::size_t size() const { return values.size(); }
+    void reserve( std::size_t n ) { reserved = n; values.reserve( n ); }
+    void push_back( int x ) { values.push_back( x ); }
+};
+
+} // anonymous namespace
+
+CASE( "collect(): Returns the values of a range of status_values if all succeed" )
+{
+    std::vector< status_value<int, int> > results;
+    results.emplace_back( 0, 1 );
+    results.emplace_back( 0, 2 );
+    results.emplace_back( 0, 3 );
+
+    status_value< int, std::vector<int> > sv = collect( results );
+
+    EXPECT( sv.has_value() );
+    EXPECT( sv.status() == 0 );
+    EXPECT( sv.value() == ( std::vector<int>{ 1, 2, 3 } ) );
+    EXPECT( collect( results, 42 ).status() == 42 );
+}
+
+CASE( "collect(): Returns the status of the first failure" )
+{
+    auto const results = make_counted( { 0, 0, 7, 0, 9 } );
+
+    status_value< int, std::vector<copy_move_counter> > sv = collect( results );
+
+    EXPECT( !sv );
+    EXPECT( sv.status() == 7 );
+}
+
+CASE( "collect(): Moves the values out of an rvalue range and copies them from an lvalue range" )
+{
+    auto results = make_counted( { 0, 0, 0, 0, 0 } );
+
+    copy_move_counter::reset();
+    auto copied = collect( results );
+
+    EXPECT( copied.value().size() == 5u );
+    EXPECT( copy_move_counter::copies == 5 );
+
+    copy_move_counter::reset();
+    auto moved = collect( std::move( results ) );
+
+    EXPECT( moved.value().size() == 5u );
+    EXPECT( copy_move_counter::copies == 0 );
+}
+
+CASE( "collect(): Copies the values from an rvalue span of an lvalue range" )
+{
+    auto results = make_counted( { 0, 0, 0 } );
+
+    copy_move_counter::reset();
+    auto copied = collect( element_span<counted_result>{ results.data(), results.data() + results.size() } );
+
+    EXPECT( copied.value().size() == 3u );
+    EXPECT( copy_move_counter::copies == 3 );
+
+    copy_move_counter::reset();
+    auto const all = collect_all( element_span<counted_result>{ results.data(), results.data() + results.size() } );
+
+    EXPECT( all.value().size() == 3u );
+    EXPECT( copy_move_counter::copies == 3 );
+}
+
+CASE( "collect(): Copies the values from an rvalue view of an lvalue range (C++20)" )
+{
+#if nsstsv_HAVE_STD_RANGES
+    auto results = make_counted( { 0, 0, 0, 0 } );
+
+    copy_move_counter::reset();
+    auto copied = collect( std::views::take( results, 3 ) );
+
+    EXPECT( copied.value().size() == 3u );
+    EXPECT( copy_move_counter::copies == 3 );
+
+    std::vector<copy_move_counter> values;
+
+    copy_move_counter::reset();
+    auto appended = collect_into( std::views::take( results, 2 ), values );
+
+    EXPECT( appended.value() == 2u );
+    EXPECT( copy_move_counter::copies == 2 );
+#else
+    EXPECT( !!"collect(): ranges are not available (no C++20)" );
+#endif
+}
+
+CASE( "collect_into(): Appends the values up to the first failure and returns their number" )
+{
+    std::vector< status_value<int, int> > results;
+    results.emplace_back( 0, 1 );
+    results.emplace_back( 0, 2 );
+    results.emplace_back( 5 );
+    results.emplace_back( 0, 4 );
+
+    std::vector<int> values( 1, 0 );
+
+    status_value<int, std::size_t> sv = collect_into( results, values );
+
+    EXPECT( !sv );
+    EXPECT( sv.status() == 5 );
+    EXPECT( values == ( std::vector<int>{ 0, 1, 2 } ) );
+
+    results.pop_back();
+    results.pop_back();
+
+    EXPECT( collect_into( results, values ).value() == 2u );
+    EXPECT( values.size() == 5u );
+}
+
+CASE( "collect_into(): Reserves room for a range with size(), and for a C array" )
+{
+    std::vector< status_value<int, int> > results;
+    results.emplace_back( 0, 1 );
+    results.emplace_back( 0, 2 );
+
+    reserve_recorder out;
+    out.values.push_back( 0 );
+
+    collect_into( results, out );
+
+    EXPECT( out.reserved == 3u );
+
+    status_value<int, int> array[] = { status_value<int, int>( 0, 4 ), status_value<int, int>( 0, 5 ), status_value<int, int>( 0, 6 ) };
+
+    collect_into( array, out );
+
+    EXPECT( out.reserved == 6u );
+    EXPECT( out.values == ( std::vector<int>{ 0, 1, 2, 4, 5, 6 } ) );
+}
+
+CASE( "collect_all(): Returns the values if all succeed, or the statuses of all failures" )
+{
+    auto const failed = collect_all( make_counted( { 0, 3, 0, 5, 7 } ) );
+
+    EXPECT( !failed );
+    EXPECT( failed.status().size() == 3u );
+    EXPECT( failed.status()[0] == 3 );
+    EXPECT( failed.status()[2] == 7 );
+
+    auto const succeeded = collect_all<2>( make_counted( { 0, 0 } ) );
+
+    EXPECT( succeeded.has_value() );
+    EXPECT( succeeded.status().ok() );
+    EXPECT( succeeded.value()[1].value == 1 );
+}
+
+// -----------------------------------------------------------------------
+// combine(), combine_by()
+
+CASE( "combine(): Moves the values of status_values that all succeed into a tuple" )
+{
+    status_value<int, copy_move_counter> a( 1, copy_move_counter( 7 ) );
+    status_value<int, std::string> b( 2, std::string( "x" ) );
+    status_value<int, double> c( 3, 1.5 );
+
+    copy_move_counter::reset();
+
+    status_value< int, std::tuple<copy_move_counter, std::string, double> > sv = combine( std::move( a ), std::move( b ), std::move( c ) );
+
+    EXPECT( sv.has_value() );
+    EXPECT( sv.status() == 1 );
+    EXPECT( std::get<0>( sv.value() ).value == 7 );
+    EXPECT( std::get<1>( sv.value() ) == "x" );
+    EXPECT( std::get<2>( sv.value() ) == 1.5 );
+    EXPECT( copy_move_counter::copies == 0 );
+#if nsstsv_CPP17_OR_GREATER
+    EXPECT( copy_move_counter::moves  == 1 );
+#endif
+}
+
+CASE( "combine(): Returns the status of the first failure" )
+{
+    status_value<int, int> a( 0, 1 );
+    status_value<int, int> b( 4 );
+    status_value<int, int> c( 5 );
+
+    auto const sv = combine( a, b, c );
+
+    EXPECT( !sv );
+    EXPECT( sv.status() == 4 );
+}
+
+CASE( "combine(): Allows to combine into a packed<>, and referred values by reference" )
+{
+    int x = 3;
+    status_value<int, char> a( 0, 'a' );
+    status_value<int, int &> b( 0, x );
+
+    status_value< int, packed<char, int> > p = combine<packed>( a, status_value<int, int>( 0, 42 ) );
+    status_value< int, std::tuple<char, int &> > t = combine( a, b );
+
+    EXPECT( get<1>( p.value() ) == 42 );
+    EXPECT( &std::get<1>( t.value() ) == &x );
+}
+
+CASE( "combine_by(): Returns the status of the most severe failure by the given order" )
+{
+    status_value<int, int> a( 2 );
+    status_value<int, int> b( 0, 1 );
+    status_value<int, int> c( 9 );
+    status_value<int, int> d( 9 );
+
+    auto const less_severe = []( int x, int y ) { return x < y; };
+
+    EXPECT( combine_by( less_severe, a, b, c, d ).status() == 9 );
+    EXPECT( combine_by( less_severe, b, a ).status() == 2 );
+    EXPECT( combine_by( less_severe, b, b ).value() == ( std::tuple<int, int>( 1, 1 ) ) );
+}
+
+// -----------------------------------------------------------------------
+// encode_batch(), decode_batch()
+
+namespace {
+
+enum class io_errc : short { ok = 0, timeout = -3, refused = 7 };
+
+status_value_vector<io_errc, long> make_io_batch( std::size_t n )
+{
+    status_value_vector<io_errc, long> batch;
+
+    for ( std::size_t i = 0; i < n; ++i )
+    {
+        if ( i % 97 == 5 || ( i > 300 && i < 340 ) )
+            batch.emplace_back( i % 2 ? io_errc::timeout : io_errc::refused );
+        else
+            batch.emplace_back( io_errc::ok, 1000L - 3 * long( i ) );
+    }
+    return batch;
+}
+
+bool same_batch( status_value_vector<io_errc, long> const & a, status_value_vector<io_errc, long> const & b )
+{
+    if ( a.size() != b.size() )
+        return false;
+
+    for ( std::size_t i = 0; i < a.size(); ++i )
+    {
+        if ( a.status( i ) != b.status( i ) || a.has_value( i ) != b.has_value( i ) || ( a.has_value( i ) && a.value( i ) != b.value( i ) ) )
+            return false;
+    }
+    return true;
+}
+
+} // anonymous namespace
+
+CASE( "encode_batch(): Round-trips statuses, engagement and raw values through decode_batch()" )
+{
+    auto const batch = make_io_batch( 1000 );
+
+    std::vector<unsigned char> bytes;
+    encode_batch( batch, bytes );
+
+    status_value_vector<io_errc, long> decoded;
+    status_value<batch_format_errc, std::size_t> read = decode_batch( bytes.data(), bytes.size(), decoded );
+
+    EXPECT( read.value() == bytes.size() );
+    EXPECT( same_batch( batch, decoded ) );
+}
+
+CASE( "encode_batch(): Round-trips integral values as bit-packed deltas, smaller than raw" )
+{
+    auto const batch = make_io_batch( 1000 );
+
+    std::vector<unsigned char> raw, delta;
+    encode_batch( batch, raw );
+    encode_batch( batch, delta, batch_value_encoding::delta );
+
+    status_value_vector<io_errc, long> decoded;
+
+    EXPECT( decode_batch( delta.data(), delta.size(), decoded ).value() == delta.size() );
+    EXPECT( same_batch( batch, decoded ) );
+    EXPECT( delta.size() < raw.size() / 4 );
+}
+
+CASE( "encode_batch(): Round-trips values over blocks of deltas of different widths and stretches of engaged elements" )
+{
+    status_value_vector<io_errc, long> batch;
+    long value = 0;
+
+    for ( std::size_t i = 0; i < 5000; ++i )
+    {
+        value += i < 2500 ? 1 + long( i % 3 ) : ( i % 2 ? 1L << 40 : -( 1L << 39 ) );
+
+        if ( i > 2100 && i % 13 == 0 )
+            batch.emplace_back( io_errc::timeout );
+        else
+            batch.emplace_back( io_errc::ok, value );
+    }
+
+    std::vector<unsigned char> raw, delta;
+    encode_batch( batch, raw );
+    encode_batch( batch, delta, batch_value_encoding::delta );
+
+    status_value_vector<io_errc, long> decoded;
+
+    EXPECT( decode_batch( raw.data(), raw.size(), decoded ).value() == raw.size() );
+    EXPECT( same_batch( batch, decoded ) );
+    EXPECT( decode_batch( delta.data(), delta.size(), decoded ).value() == delta.size() );
+    EXPECT( same_batch( batch, decoded ) );
+    EXPECT( decode_batch( delta.data(), delta.size() - 8, decoded ).status() == batch_format_errc::truncated );
+    EXPECT( decoded.empty() );
+}
+
+namespace {
+
+struct record_200
+{
+    unsigned char bytes[200];
+};
+
+template< typename V, typename Fill >
+bool round_trips_raw( std::size_t n, Fill fill )
+{
+    status_value_vector<io_errc, V> batch, decoded;
+
+    for ( std::size_t i = 0; i < n; ++i )
+    {
+        if ( i % 3 == 1 || ( i > 500 && i < 700 ) )
+            batch.emplace_back( io_errc::refused );
+        else
+            batch.emplace_back( io_errc::ok, fill( i ) );
+    }
+
+    std::vector<unsigned char> bytes;
+    encode_batch( batch, bytes );
+
+    status_value<batch_format_errc, std::size_t> const read = decode_batch( bytes.data(), bytes.size(), decoded );
+
+    if ( ! read || read.value() != bytes.size() || decoded.size() != n )
+        return false;
+
+    for ( std::size_t i = 0; i < n; ++i )
+    {
+        if ( decoded.has_value( i ) != batch.has_value( i ) || ( batch.has_value( i ) && std::memcmp( &decoded.value( i ), &batch.value( i ), sizeof(V) ) != 0 ) )
+            return false;
+    }
+    return true;
+}
+
+} // anonymous namespace
+
+CASE( "encode_batch(): Round-trips raw values of other sizes than 4 or 8 bytes" )
+{
+    EXPECT( round_trips_raw<std::int16_t>( 3000, []( std::size_t i ) { return std::int16_t( i ); } ) );
+    EXPECT( round_trips_raw<record_200  >( 3000, []( std::size_t i ) { record_200 r; std::memset( r.bytes, int( i % 251 ), sizeof r.bytes ); return r; } ) );
+}
+
+CASE( "encode_batch(): Encodes runs of equal statuses in a few bytes" )
+{
+    status_value_vector<io_errc, double> batch;
+
+    for ( int i = 0; i < 4096; ++i )
+        batch.emplace_back( io_errc::refused );
+
+    std::vector<unsigned char> bytes;
+    encode_batch( batch, bytes );
+
+    // header, one run of zero-width code, one length and the bitmap:
+
+    EXPECT( bytes.size() == 48u + 8u + 4096u / 8u );
+}
+
+CASE( "decode_batch(): Reads consecutive batches from a buffer" )
+{
+    auto const first = make_io_batch( 100 );
+    auto const second = make_io_batch( 3 );
+
+    std::vector<unsigned char> bytes;
+    encode_batch( first, bytes );
+    encode_batch( second, bytes, batch_value_encoding::delta );
+
+    status_value_vector<io_errc, long> a, b;
+    std::size_t const n = decode_batch( bytes.data(), bytes.size(), a ).value();
+
+    EXPECT( decode_batch( bytes.data() + n, bytes.size() - n, b ).value() == bytes.size() - n );
+    EXPECT( same_batch( first, a ) );
+    EXPECT( same_batch( second, b ) );
+}
+
+CASE( "decode_batch(): Reports a truncated, foreign or mismatching encoding and leaves the batch empty" )
+{
+    std::vector<unsigned char> bytes;
+    encode_batch( make_io_batch( 100 ), bytes );
+
+    status_value_vector<io_errc, long> decoded = make_io_batch( 10 );
+    status_value_vector<io_errc, int> other;
+
+    EXPECT( decode_batch( bytes.data(), bytes.size() - 1, decoded ).status() == batch_format_errc::truncated );
+    EXPECT( decoded.empty() );
+    EXPECT( decode_batch( bytes.data(), bytes.size(), other ).status() == batch_format_errc::type_mismatch );
+
+    bytes[0] = 'X';
+
+    EXPECT( decode_batch( bytes.data(), bytes.size(), decoded ).status() == batch_format_errc::bad_magic );
+}
+
+CASE( "decode_batch(): Reports run lengths that do not add up to the size before taking room for it" )
+{
+    status_value_vector<io_errc, long> failures;
+
+    for ( int i = 0; i < 100; ++i )
+        failures.emplace_back( io_errc::refused );
+
+    std::vector<unsigned char> bytes;
+    encode_batch( failures, bytes );
+
+    // claim fewer elements than the run holds:
+
+    std::uint64_t const size = 64;
+    std::memcpy( bytes.data() + 8, &size, sizeof size );
+
+    status_value_vector<io_errc, long> decoded;
+
+    EXPECT( decode_batch( bytes.data(), bytes.size(), decoded ).status() == batch_format_errc::corrupt );
+    EXPECT( decoded.capacity() == 0u );
+}
+
+CASE( "decode_batch(): Reports values of the same size but of another kind, and another byte order, as a mismatch" )
+{
+    status_value_vector<io_errc, long> longs = make_io_batch( 10 );
+    status_value_vector<io_errc, double> doubles;
+    status_value_vector<io_errc, unsigned long> unsigned_longs;
+    status_value_vector<short, long> shorts;
+
+    doubles.emplace_back( io_errc::ok, 1.5 );
+
+    std::vector<unsigned char> long_bytes, double_bytes;
+    encode_batch( longs, long_bytes );
+    encode_batch( doubles, double_bytes );
+
+    EXPECT( decode_batch( long_bytes.data(), long_bytes.size(), doubles ).status() == batch_format_errc::type_mismatch );
+    EXPECT( decode_batch( double_bytes.data(), double_bytes.size(), longs ).status() == batch_format_errc::type_mismatch );
+    EXPECT( decode_batch( long_bytes.data(), long_bytes.size(), unsigned_longs ).status() == batch_format_errc::type_mismatch );
+    EXPECT( decode_batch( long_bytes.data(), long_bytes.size(), shorts ).value() == long_bytes.size() );
+
+    // the byte order marker, at offset 44, as written by a host of the other byte order:
+
+    std::swap( long_bytes[44], long_bytes[45] );
+
+    EXPECT( decode_batch( long_bytes.data(), long_bytes.size(), longs ).status() == batch_format_errc::byte_order_mismatch );
+    EXPECT( longs.empty() );
+}
+
+// -----------------------------------------------------------------------
+// views::engaged_values, views::statuses, views::failures
+
+#if nsstsv_HAVE_STD_RANGES
+
+namespace {
+
+std::vector< status_value<int, int> > make_results( std::initializer_list<int> codes )
+{
+    std::vector< status_value<int, int> > results;
+
+    for ( int code : codes )
+    {
+        if ( code == 0 ) results.emplace_back( 0, 10 * int( results.size() ) );
+        else             results.emplace_back( code );
+    }
+    return results;
+}
+
+} // anonymous namespace
+
+#endif
+
+CASE( "views::engaged_values: Yields references to the values of the engaged elements (C++20)" )
+{
+#if nsstsv_HAVE_STD_RANGES
+    auto results = make_results( { 0, 3, 0, 0, 5 } );
+
+    std::vector<int> values;
+    for ( int & x : results | views::engaged_values )
+    {
+        values.push_back( x );
+        x += 1;
+    }
+
+    EXPECT( values == ( std::vector<int>{ 0, 20, 30 } ) );
+    EXPECT( results[2].value() == 21 );
+    EXPECT( std::ranges::bidirectional_range< decltype( results | views::engaged_values ) > );
+#else
+    EXPECT( !!"views::engaged_values: ranges are not available (no C++20)" );
+#endif
+}
+
+CASE( "views::engaged_values: Moves the values out of prvalue elements without copies (C++20)" )
+{
+#if nsstsv_HAVE_STD_RANGES
+    auto make = []( int i ) { return i % 3 ? status_value<int, copy_move_counter>( 0, copy_move_counter( i ) ) : status_value<int, copy_move_counter>( 1 ); };
+
+    copy_move_counter::reset();
+
+    int sum = 0;
+    for ( copy_move_counter c : std::views::iota( 0, 6 ) | std::views::transform( make ) | views::engaged_values )
+    {
+        sum += c.value;
+    }
+
+    EXPECT( sum == 1 + 2 + 4 + 5 );
+    EXPECT( copy_move_counter::copies == 0 );
+#else
+    EXPECT( !!"views::engaged_values: ranges are not available (no C++20)" );
+#endif
+}
+
+CASE( "views::engaged_values: Yields references into a status_value_vector (C++20)" )
+{
+#if nsstsv_HAVE_STD_RANGES
+    status_value_vector<int, int> batch;
+    batch.emplace_back( 0, 1 );
+    batch.emplace_back( 2 );
+    batch.emplace_back( 0, 3 );
+
+    EXPECT( std::ranges::random_access_range< decltype( batch ) > );
+
+    std::vector<int> values;
+    for ( int & x : batch | views::engaged_values )
+    {
+        values.push_back( x );
+        x = 0;
+    }
+
+    EXPECT( values == ( std::vector<int>{ 1, 3 } ) );
+    EXPECT( batch[2].value() == 0 );
+#else
+    EXPECT( !!"views::engaged_values: ranges are not available (no C++20)" );
+#endif
+}
+
+CASE( "views::statuses: Yields references to the statuses and keeps the category and size of the range (C++20)" )
+{
+#if nsstsv_HAVE_STD_RANGES
+    auto const results = make_results( { 0, 3, 0, 5 } );
+    auto statuses = results | views::statuses;
+
+    EXPECT( std::ranges::random_access_range< decltype( statuses ) > );
+    EXPECT( std::ranges::size( statuses ) == 4u );
+    EXPECT( statuses[1] == 3 );
+    EXPECT( &statuses[3] == &results[3].status() );
+#else
+    EXPECT( !!"views::statuses: ranges are not available (no C++20)" );
+#endif
+}
+
+CASE( "views::failures: Yields the statuses of the failed elements (C++20)" )
+{
+#if nsstsv_HAVE_STD_RANGES
+    auto const results = make_results( { 0, 3, 0, 5, 7, 0 } );
+
+    std::vector<int> codes;
+    for ( int const & code : results | views::failures )
+    {
+        codes.push_back( code );
+    }
+
+    EXPECT( codes == ( std::vector<int>{ 3, 5, 7 } ) );
+    EXPECT( &*( results | views::failures ).begin() == &results[1].status() );
+#else
+    EXPECT( !!"views::failures: ranges are not available (no C++20)" );
+#endif
+}
+
+CASE( "views: Compose with the standard views (C++20)" )
+{
+#if nsstsv_HAVE_STD_RANGES
+    auto const results = make_results( { 3, 0, 0, 5, 0, 0 } );
+
+    std::vector<int> last_two, first_failure;
+
+    for ( int x : results | views::engaged_values | std::views::reverse | std::views::take( 2 ) )
+        last_two.push_back( x );
+
+    for ( int code : results | std::views::drop( 1 ) | views::failures | std::views::take( 1 ) )
+        first_failure.push_back( code );
+
+    EXPECT( last_two == ( std::vector<int>{ 50, 40 } ) );
+    EXPECT( first_failure == ( std::vector<int>{ 5 } ) );
+#else
+    EXPECT( !!"views: ranges are not available (no C++20)" );
+#endif
+}
+
 CASE( "tweak header: reads tweak header if supported " "[tweak]" )
 {
 #if nsstsv_HAVE_TWEAK_HEADER
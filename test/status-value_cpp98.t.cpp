@@ -13,6 +13,9 @@
 
 #include "lest_cpp03.hpp"
 
+#include <string>
+#include <vector>
+
 #define CASE( name ) lest_CASE( specification, name )
 
 static lest::tests specification;
@@ -51,6 +54,58 @@ struct copy_constructible
     copy_constructible( copy_constructible const & other ) : x( other.x ) {}
 };
 
+// Over-aligned value types:
+
+#if nsstsv_CPP11_OR_GREATER
+# define nsstsv_TEST_ALIGNED( n )  alignas( n )
+# define nsstsv_TEST_HAVE_ALIGNED  1
+#elif defined( __GNUC__ )
+# define nsstsv_TEST_ALIGNED( n )  __attribute__(( aligned( n ) ))
+# define nsstsv_TEST_HAVE_ALIGNED  1
+#elif defined( _MSC_VER )
+# define nsstsv_TEST_ALIGNED( n )  __declspec( align( n ) )
+# define nsstsv_TEST_HAVE_ALIGNED  1
+#else
+# define nsstsv_TEST_ALIGNED( n )  /*aligned*/
+# define nsstsv_TEST_HAVE_ALIGNED  0
+#endif
+
+struct nsstsv_TEST_ALIGNED( 32 ) simd_vector
+{
+    float lane[8];
+    simd_vector( float x ) { for ( int i = 0; i < 8; ++i ) lane[i] = x; }
+};
+
+struct nsstsv_TEST_ALIGNED( 64 ) cache_line
+{
+    char data[64];
+    cache_line( char x ) { for ( int i = 0; i < 64; ++i ) data[i] = x; }
+};
+
+inline bool is_aligned( void const * p, std::size_t align )
+{
+    return reinterpret_cast<std::size_t>( p ) % align == 0;
+}
+
+// Value that counts its copies and is movable by member swap():
+
+struct copy_counted
+{
+    static int copies;
+
+    std::vector<int> data;
+
+    copy_counted() {}
+    copy_counted( std::size_t n ) : data( n ) {}
+    copy_counted( copy_counted const & other ) : data( other.data ) { ++copies; }
+#if nsstsv_CPP11_OR_GREATER
+    copy_counted( copy_counted && other ) : data( std::move( other.data ) ) {}
+#endif
+    void swap( copy_counted & other ) { data.swap( other.data ); }
+};
+
+int copy_counted::copies = 0;
+
 // -----------------------------------------------------------------------
 // status_value<>
 
@@ -357,6 +412,65 @@ CASE( "status_value<>: Throws when observing non-engaged (operator->())" )
 #endif
 }
 
+// -----------------------------------------------------------------------
+// status_value<> of over-aligned value
+
+CASE( "status_value<>: Aligns an over-aligned value (32 bytes)" )
+{
+#if nsstsv_TEST_HAVE_ALIGNED
+    status_value<char, simd_vector> sv( 'x', simd_vector( 1.5f ) );
+
+    EXPECT( is_aligned( &sv.value(), 32 ) );
+    EXPECT( sizeof( status_value<char, simd_vector> ) % 32 == 0u );
+    EXPECT( sv.value().lane[7] == 1.5f );
+#else
+    EXPECT( !!"status_value: over-aligned types are not available (no alignment extension)" );
+#endif
+}
+
+CASE( "status_value<>: Aligns an over-aligned value (64 bytes)" )
+{
+#if nsstsv_TEST_HAVE_ALIGNED
+    status_value<char, cache_line> sv1( 'x', cache_line( 'a' ) );
+    status_value<char, cache_line> sv2( 'y', cache_line( 'b' ) );
+
+    EXPECT( is_aligned( &sv1.value(), 64 ) );
+    EXPECT( is_aligned( &sv2.value(), 64 ) );
+    EXPECT( sizeof( status_value<char, cache_line> ) % 64 == 0u );
+    EXPECT( sv2.value().data[63] == 'b' );
+#else
+    EXPECT( !!"status_value: over-aligned types are not available (no alignment extension)" );
+#endif
+}
+
+// -----------------------------------------------------------------------
+// status_value<> move emulation
+
+CASE( "status_value<>: Allows move-construction via nonstd::move() without copying status and value" )
+{
+    status_value<std::string, copy_counted> sv1( std::string( 100, 's' ), copy_counted( 1000 ) );
+    char const * status = sv1.status().data();
+
+    copy_counted::copies = 0;
+
+    status_value<std::string, copy_counted> sv2( nonstd::move( sv1 ) );
+
+    EXPECT( !sv1 );
+    EXPECT( copy_counted::copies == 0 );
+    EXPECT( sv2.status().data() == status );
+    EXPECT( sv2.value().data.size() == 1000u );
+}
+
+CASE( "status_value<>: Allows move-construction via nonstd::move() of a value without member swap()" )
+{
+    status_value<int, copy_constructible> sv1( 7, copy_constructible( 42 ) );
+    status_value<int, copy_constructible> sv2( nonstd::move( sv1 ) );
+
+    EXPECT( !sv1 );
+    EXPECT( sv2.status() == 7 );
+    EXPECT( sv2.value().x == 42 );
+}
+
 CASE( "tweak header: reads tweak header if supported " "[tweak]" )
 {
 #if nsstsv_HAVE_TWEAK_HEADER